@@ -0,0 +1,404 @@
+/***********************************************************************
+ * Header:
+ *    BIT VECTOR
+ * Summary:
+ *    A vector of bools packed 64 to a word
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        bit_vector            : A class that represents a packed bitmap
+ *        bit_vector::reference : A proxy for one bit
+ *        bit_vector::iterator  : An interator through bit_vector
+ *
+ *    count, find_first, find_next and the &=, |= and ^= operators all
+ *    work a whole 64 bit word at a time, using the popcnt and tzcnt
+ *    instructions when the compiler has them.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <cstdint>      // for uint64_t
+#include "vector.h"     // the words live in a vector
+#ifdef _MSC_VER
+#include <intrin.h>     // for __popcnt64 and _BitScanForward64
+#endif
+
+class TestBitVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************
+     * BIT VECTOR
+     * Like vector <bool>, but eight times smaller
+     ****************************************/
+    class bit_vector
+    {
+        friend class ::TestBitVector; // give unit tests access to the privates
+    public:
+        class reference;
+        class iterator;
+
+        //
+        // Construct
+        //
+
+        bit_vector() : numBits(0) {}
+        bit_vector(size_t num, bool value = false) : numBits(0) { resize(num, value); }
+
+        //
+        // Assign
+        //
+
+        void swap(bit_vector& rhs)
+        {
+            words.swap(rhs.words);
+            size_t temp = rhs.numBits;
+            rhs.numBits = numBits;
+            numBits = temp;
+        }
+
+        //
+        // Iterator
+        //
+
+        iterator begin();
+        iterator end();
+
+        //
+        // Access
+        //
+
+        reference operator [] (size_t index);
+        bool operator [] (size_t index) const { return test(index); }
+        bool test(size_t index) const { return (words[index / 64] >> (index % 64)) & 1; }
+
+        //
+        // Insert
+        //
+
+        void push_back(bool value);
+        void resize(size_t num, bool value = false);
+        void reserve(size_t num) { words.reserve(wordsFor(num)); }
+
+        //
+        // Remove
+        //
+
+        void clear()
+        {
+            words.clear();
+            numBits = 0;
+        }
+        void pop_back()
+        {
+            if (numBits != 0)
+                resize(numBits - 1);
+        }
+
+        //
+        // Bit operations
+        //
+
+        void set(size_t index) { words[index / 64] |= bit(index); }
+        void reset(size_t index) { words[index / 64] &= ~bit(index); }
+        void flip(size_t index) { words[index / 64] ^= bit(index); }
+        void flip();
+        bit_vector& operator &= (const bit_vector& rhs);
+        bit_vector& operator |= (const bit_vector& rhs);
+        bit_vector& operator ^= (const bit_vector& rhs);
+
+        //
+        // Search
+        //
+
+        size_t count() const;
+        size_t find_first() const { return find_from(0); }
+        size_t find_next(size_t index) const { return find_from(index + 1); }
+
+        //
+        // Status
+        //
+
+        size_t size()     const { return numBits; }
+        size_t capacity() const { return words.capacity() * 64; }
+        bool empty()      const { return numBits == 0; }
+
+    private:
+
+        static uint64_t bit(size_t index) { return uint64_t(1) << (index % 64); }
+        static size_t wordsFor(size_t num) { return (num + 63) / 64; }
+        static size_t popcount(uint64_t word);
+        static size_t lowestBit(uint64_t word);
+
+        size_t find_from(size_t index) const;
+        void trim();
+
+        vector<uint64_t> words;   // bit i is bit i % 64 of words[i / 64]
+        size_t numBits;           // the number of bits currently used
+    };
+
+    /**************************************************
+     * BIT VECTOR REFERENCE
+     * What operator [] hands back, since a single
+     * bit has no address
+     *************************************************/
+    class bit_vector::reference
+    {
+        friend class ::TestBitVector; // give unit tests access to the privates
+    public:
+        reference(uint64_t* pWord, uint64_t mask) : pWord(pWord), mask(mask) {}
+
+        operator bool () const { return (*pWord & mask) != 0; }
+        reference& operator = (bool value)
+        {
+            if (value)
+                *pWord |= mask;
+            else
+                *pWord &= ~mask;
+            return *this;
+        }
+        reference& operator = (const reference& rhs) { return *this = bool(rhs); }
+        void flip() { *pWord ^= mask; }
+
+    private:
+        uint64_t* pWord;
+        uint64_t mask;
+    };
+
+    /**************************************************
+     * BIT VECTOR ITERATOR
+     * An iterator through bit_vector. Dereferencing
+     * gives a reference proxy.
+     *************************************************/
+    class bit_vector::iterator
+    {
+        friend class ::TestBitVector; // give unit tests access to the privates
+    public:
+        // constructors, destructors, and assignment operator
+        iterator() : index(0), v(nullptr) {}
+        iterator(size_t index, bit_vector* v) : index(index), v(v) {}
+        iterator(const iterator& rhs) : index(rhs.index), v(rhs.v) {}
+        iterator& operator = (const iterator& rhs)
+        {
+            index = rhs.index;
+            v = rhs.v;
+            return *this;
+        }
+
+        // equals, not equals operator
+        bool operator != (const iterator& rhs) const { return rhs.index != index; }
+        bool operator == (const iterator& rhs) const { return rhs.index == index; }
+
+        // dereference operator
+        reference operator * () { return (*v)[index]; }
+
+        // prefix increment
+        iterator& operator ++ ()
+        {
+            index++;
+            return *this;
+        }
+
+        // postfix increment
+        iterator operator ++ (int)
+        {
+            iterator returnCopy(*this);
+            index++;
+            return returnCopy;
+        }
+
+        // prefix decrement
+        iterator& operator -- ()
+        {
+            index--;
+            return *this;
+        }
+
+        // postfix decrement
+        iterator operator -- (int)
+        {
+            iterator returnCopy(*this);
+            index--;
+            return returnCopy;
+        }
+
+    private:
+        size_t index;
+        bit_vector* v;
+    };
+
+    inline bit_vector::iterator bit_vector::begin() { return iterator(0, this); }
+    inline bit_vector::iterator bit_vector::end() { return iterator(numBits, this); }
+
+    /*****************************************
+     * BIT VECTOR :: SUBSCRIPT
+     * Read-Write access through a proxy
+     ****************************************/
+    inline bit_vector::reference bit_vector::operator [] (size_t index)
+    {
+        return reference(&words[index / 64], bit(index));
+    }
+
+    /*****************************************
+     * BIT VECTOR :: POPCOUNT and LOWEST BIT
+     * One instruction each where the compiler
+     * knows how, a short loop otherwise
+     ****************************************/
+    inline size_t bit_vector::popcount(uint64_t word)
+    {
+#if defined(__GNUC__)
+        return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<size_t>(__popcnt64(word));
+#else
+        size_t c = 0;
+        for (; word; word &= word - 1)
+            c++;
+        return c;
+#endif
+    }
+
+    inline size_t bit_vector::lowestBit(uint64_t word)
+    {
+        assert(word != 0);
+#if defined(__GNUC__)
+        return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return index;
+#else
+        size_t i = 0;
+        while (!(word & 1))
+        {
+            word >>= 1;
+            i++;
+        }
+        return i;
+#endif
+    }
+
+    /*****************************************
+     * BIT VECTOR :: TRIM
+     * Keep the bits past size() in the last word
+     * zero so count and find never see them
+     ****************************************/
+    inline void bit_vector::trim()
+    {
+        if (numBits % 64)
+            words[numBits / 64] &= bit(numBits) - 1;
+    }
+
+    /***************************************
+     * BIT VECTOR :: RESIZE
+     * Grow or shrink to num bits; new bits get value
+     **************************************/
+    inline void bit_vector::resize(size_t num, bool value)
+    {
+        size_t oldBits = numBits;
+        words.resize(wordsFor(num), value ? ~uint64_t(0) : uint64_t(0));
+
+        // the tail of the old last word was zero
+        if (value && num > oldBits && oldBits % 64)
+            words[oldBits / 64] |= ~(bit(oldBits) - 1);
+
+        numBits = num;
+        trim();
+    }
+
+    /***************************************
+     * BIT VECTOR :: PUSH BACK
+     **************************************/
+    inline void bit_vector::push_back(bool value)
+    {
+        if (numBits % 64 == 0)
+            words.push_back(0);
+        if (value)
+            set(numBits);
+        numBits++;
+    }
+
+    /***************************************
+     * BIT VECTOR :: FLIP
+     * Flip every bit, a word at a time
+     **************************************/
+    inline void bit_vector::flip()
+    {
+        for (size_t i = 0; i < words.size(); i++)
+            words[i] = ~words[i];
+        trim();
+    }
+
+    /***************************************
+     * BIT VECTOR :: AND, OR, XOR
+     * Both bit vectors must be the same size
+     **************************************/
+    inline bit_vector& bit_vector::operator &= (const bit_vector& rhs)
+    {
+        assert(numBits == rhs.numBits);
+        for (size_t i = 0; i < words.size(); i++)
+            words[i] &= rhs.words[i];
+        return *this;
+    }
+
+    inline bit_vector& bit_vector::operator |= (const bit_vector& rhs)
+    {
+        assert(numBits == rhs.numBits);
+        for (size_t i = 0; i < words.size(); i++)
+            words[i] |= rhs.words[i];
+        return *this;
+    }
+
+    inline bit_vector& bit_vector::operator ^= (const bit_vector& rhs)
+    {
+        assert(numBits == rhs.numBits);
+        for (size_t i = 0; i < words.size(); i++)
+            words[i] ^= rhs.words[i];
+        return *this;
+    }
+
+    /***************************************
+     * BIT VECTOR :: COUNT
+     * The number of bits that are set
+     **************************************/
+    inline size_t bit_vector::count() const
+    {
+        size_t c = 0;
+        for (size_t i = 0; i < words.size(); i++)
+            c += popcount(words[i]);
+        return c;
+    }
+
+    /***************************************
+     * BIT VECTOR :: FIND FROM
+     * The first set bit at or after index,
+     * or size() if there is none
+     **************************************/
+    inline size_t bit_vector::find_from(size_t index) const
+    {
+        if (index >= numBits)
+            return numBits;
+
+        size_t iWord = index / 64;
+        uint64_t word = words[iWord] & ~(bit(index) - 1);
+        while (word == 0)
+        {
+            if (++iWord == words.size())
+                return numBits;
+            word = words[iWord];
+        }
+        return iWord * 64 + lowestBit(word);
+    }
+
+} // namespace custom
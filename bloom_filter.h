@@ -0,0 +1,178 @@
+/***********************************************************************
+ * Header:
+ *    BLOOM FILTER
+ * Summary:
+ *    A set of hashes that can answer "certainly not here"
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        blocked_bloom_filter  : A Bloom filter split into cache lines
+ *
+ *    Every hash lands in one 64 byte block of eight words and sets one
+ *    bit in each word. Adding a hash or asking about one touches a
+ *    single cache line, instead of k lines scattered across the filter.
+ *    At the default 16 bits per key about one miss in a few hundred
+ *    gets a false "maybe".
+ *
+ *    It stores hashes, not keys: the caller hashes once and hands the
+ *    same size_t to the filter and to its own table. Nothing can be
+ *    removed; clear it and insert again instead.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <cstdint>      // for uint64_t
+#include "vector.h"     // the blocks live in a vector
+
+class TestBloomFilter; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************
+     * BLOCKED BLOOM FILTER
+     * A power of two number of cache line
+     * sized blocks
+     ****************************************/
+    class blocked_bloom_filter
+    {
+        friend class ::TestBloomFilter; // give unit tests access to the privates
+    public:
+        static const size_t BITS_PER_KEY = 16;
+
+        //
+        // Construct
+        //
+
+        blocked_bloom_filter() : blockBits(0) {}
+        explicit blocked_bloom_filter(size_t numKeys) : blockBits(0) { resize(numKeys); }
+
+        //
+        // Assign
+        //
+
+        void swap(blocked_bloom_filter& rhs)
+        {
+            words.swap(rhs.words);
+            unsigned temp = rhs.blockBits;
+            rhs.blockBits = blockBits;
+            blockBits = temp;
+        }
+
+        //
+        // Access
+        //
+
+        bool might_contain(size_t hash) const;
+
+        //
+        // Insert
+        //
+
+        void insert(size_t hash);
+        void resize(size_t numKeys);
+
+        //
+        // Remove
+        //
+
+        void clear();
+
+        //
+        // Status
+        //
+
+        size_t block_count() const { return words.size() / WORDS; }
+        bool empty() const { return words.empty(); }
+
+    private:
+
+        static const size_t WORDS = 8;   // 64 bit words in a 64 byte block
+
+        // one more multiply so std::hash of an integer, which is
+        // the integer, still spreads across blocks and bits
+        static uint64_t mix(size_t hash) { return static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull; }
+        size_t blockFor(uint64_t mixed) const { return blockBits ? size_t(mixed >> (64 - blockBits)) : 0; }
+
+        // the low bits of a product are poor, so the bits within the block
+        // come from the top half, multiplied again
+        static uint64_t spread(uint64_t mixed) { return ((mixed >> 32) | (mixed << 32)) * 0xC2B2AE3D27D4EB4Full; }
+        static uint64_t bitFor(uint64_t spread, size_t j) { return uint64_t(1) << ((spread >> (6 * j)) & 63); }
+
+        vector<uint64_t, 64> words;   // block i is words [8i, 8i + 8)
+        unsigned blockBits;           // log2 of the number of blocks
+    };
+
+    /*****************************************
+     * BLOCKED BLOOM FILTER :: RESIZE
+     * Make room for numKeys at BITS_PER_KEY each,
+     * rounded up to a power of two blocks. This
+     * forgets everything inserted so far.
+     ****************************************/
+    inline void blocked_bloom_filter::resize(size_t numKeys)
+    {
+        size_t numBlocks = 1;
+        blockBits = 0;
+        while (numBlocks * WORDS * 64 < numKeys * BITS_PER_KEY)
+        {
+            numBlocks *= 2;
+            blockBits++;
+        }
+
+        words.clear();
+        words.resize(numBlocks * WORDS, uint64_t(0));
+    }
+
+    /*****************************************
+     * BLOCKED BLOOM FILTER :: CLEAR
+     * Forget every hash but keep the blocks
+     ****************************************/
+    inline void blocked_bloom_filter::clear()
+    {
+        for (size_t i = 0; i < words.size(); i++)
+            words[i] = 0;
+    }
+
+    /*****************************************
+     * BLOCKED BLOOM FILTER :: INSERT
+     ****************************************/
+    inline void blocked_bloom_filter::insert(size_t hash)
+    {
+        assert(!empty());
+        uint64_t mixed = mix(hash);
+        uint64_t bits = spread(mixed);
+        uint64_t* block = &words[blockFor(mixed) * WORDS];
+        for (size_t j = 0; j < WORDS; j++)
+            block[j] |= bitFor(bits, j);
+    }
+
+    /*****************************************
+     * BLOCKED BLOOM FILTER :: MIGHT CONTAIN
+     *     OUTPUT : false if hash was certainly never
+     *              inserted
+     ****************************************/
+    inline bool blocked_bloom_filter::might_contain(size_t hash) const
+    {
+        if (empty())
+            return true;
+
+        uint64_t mixed = mix(hash);
+        uint64_t bits = spread(mixed);
+        const uint64_t* block = &words[blockFor(mixed) * WORDS];
+        uint64_t missing = 0;
+        for (size_t j = 0; j < WORDS; j++)
+            missing |= bitFor(bits, j) & ~block[j];
+        return missing == 0;
+    }
+
+} // namespace custom
@@ -0,0 +1,294 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT UNORDERED SET
+ * Summary:
+ *    A hash set that many threads can use at once
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        concurrent_unordered_set : A sharded, lock-striped hash set
+ *
+ *    The keys are split across a power of two number of shards, each an
+ *    unordered_set behind its own reader-writer lock. The high bits of
+ *    the (mixed) hash pick the shard and the inner set uses the rest, so
+ *    two threads only wait for each other when they touch the same shard,
+ *    and readers of a shard never wait for each other at all. Each key is
+ *    hashed once; the shard's set is handed the same hash.
+ *
+ *    There are no iterators, since another thread could change the set
+ *    underneath one. Use for_each to visit every element, one shard at a
+ *    time. size() adds up the shards one by one, so while other threads
+ *    are writing it is only a snapshot.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <cstdint>      // for uint64_t
+#include <memory>       // for std::align
+#include <new>          // for placement new
+#include <mutex>        // for std::unique_lock
+#include <shared_mutex> // for std::shared_lock
+#include <thread>       // for std::thread::hardware_concurrency
+#include "hash.h"       // each shard is an unordered_set
+
+class TestConcurrentUnorderedSet; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /************************************************
+     * CONCURRENT UNORDERED SET
+     * A set implemented as many hashes, each with
+     * its own lock
+     ************************************************/
+    template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+    class concurrent_unordered_set
+    {
+        friend class ::TestConcurrentUnorderedSet; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+        explicit concurrent_unordered_set(size_t numShards = 0, const Hash& hasher = Hash(),
+                                          const KeyEqual& equal = KeyEqual());
+        concurrent_unordered_set(const concurrent_unordered_set& rhs) = delete;
+        concurrent_unordered_set& operator = (const concurrent_unordered_set& rhs) = delete;
+        ~concurrent_unordered_set()
+        {
+            destroyShards(numShards);
+        }
+
+        //
+        // Access
+        //
+        bool contains(const T& t) const;
+        size_t count(const T& t) const { return contains(t) ? 1 : 0; }
+        template <class F>
+        void for_each(F f) const;
+
+        //
+        // Insert
+        //
+        bool insert(const T& t);
+        void reserve(size_t num);
+
+        //
+        // Remove
+        //
+        bool erase(const T& t);
+        void clear();
+
+        //
+        // Status
+        //
+        size_t size() const;
+        bool empty() const { return size() == 0; }
+        size_t shard_count() const { return numShards; }
+
+    private:
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+        typedef std::shared_mutex Mutex;
+#else
+        typedef std::shared_timed_mutex Mutex;
+#endif
+        typedef std::shared_lock<Mutex> ReadLock;
+        typedef std::unique_lock<Mutex> WriteLock;
+
+        // one lock and one hash, on a cache line of their own so
+        // threads on neighboring shards do not fight over it
+        struct alignas(64) Shard
+        {
+            mutable Mutex lock;
+            unordered_set<T, Hash, KeyEqual> set;
+        };
+
+        Shard& shardFor(size_t h) const;
+        void destroyShards(size_t num)
+        {
+            for (size_t i = 0; i < num; i++)
+                shards[i].~Shard();
+            delete [] storage;
+        }
+
+        unsigned char* storage; // room for the shards and the slack to align them
+        Shard* shards;        // numShards of them, in storage
+        size_t numShards;     // a power of two
+        unsigned shardBits;   // log2(numShards)
+        Hash hasher;
+    };
+
+    /*****************************************
+     * CONCURRENT UNORDERED SET :: CONSTRUCTOR
+     * Round numShards up to a power of two. By default,
+     * four shards per hardware thread.
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    concurrent_unordered_set <T, Hash, KeyEqual> ::concurrent_unordered_set(size_t numShards,
+        const Hash& hasher, const KeyEqual& equal) : hasher(hasher)
+    {
+        if (numShards == 0)
+            numShards = 4 * (std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1);
+
+        this->numShards = 1;
+        shardBits = 0;
+        while (this->numShards < numShards)
+        {
+            this->numShards *= 2;
+            shardBits++;
+        }
+
+        // new only honors alignas(64) from C++17 on, so line them up by hand
+        size_t bytes = sizeof(Shard) * this->numShards;
+        size_t space = bytes + alignof(Shard);
+        storage = new unsigned char[space];
+        void* p = storage;
+        shards = static_cast<Shard*>(std::align(alignof(Shard), bytes, p, space));
+
+        size_t num = 0;
+        try
+        {
+            for (; num < this->numShards; num++)
+                new (static_cast<void*>(shards + num)) Shard;
+            for (size_t i = 0; i < this->numShards; i++)
+                shards[i].set = unordered_set<T, Hash, KeyEqual>(8, hasher, equal);
+        }
+        catch (...)
+        {
+            destroyShards(num);
+            throw;
+        }
+    }
+
+    /*****************************************
+     * CONCURRENT UNORDERED SET :: SHARD FOR
+     * Multiply the hash by the golden ratio and keep
+     * the top bits: std::hash of a small integer has
+     * none set
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    typename concurrent_unordered_set <T, Hash, KeyEqual> ::Shard&
+        concurrent_unordered_set <T, Hash, KeyEqual> ::shardFor(size_t h) const
+    {
+        if (shardBits == 0)
+            return shards[0];
+        uint64_t mixed = static_cast<uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+        return shards[mixed >> (64 - shardBits)];
+    }
+
+    /*****************************************
+     * CONCURRENT UNORDERED SET :: CONTAINS
+     * Readers share the shard's lock. A lookup never
+     * migrates buckets, so findHashed only reads.
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    bool concurrent_unordered_set <T, Hash, KeyEqual> ::contains(const T& t) const
+    {
+        size_t h = hasher(t);
+        Shard& shard = shardFor(h);
+        ReadLock guard(shard.lock);
+        return shard.set.findHashed(t, h) != shard.set.end();
+    }
+
+    /*****************************************
+     * CONCURRENT UNORDERED SET :: INSERT
+     *     OUTPUT : true if t was not already there
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    bool concurrent_unordered_set <T, Hash, KeyEqual> ::insert(const T& t)
+    {
+        size_t h = hasher(t);
+        Shard& shard = shardFor(h);
+        WriteLock guard(shard.lock);
+        if (shard.set.findHashed(t, h) != shard.set.end())
+            return false;
+        shard.set.insertHashed(t, h);
+        return true;
+    }
+
+    /*****************************************
+     * CONCURRENT UNORDERED SET :: ERASE
+     *     OUTPUT : true if t was there
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    bool concurrent_unordered_set <T, Hash, KeyEqual> ::erase(const T& t)
+    {
+        size_t h = hasher(t);
+        Shard& shard = shardFor(h);
+        WriteLock guard(shard.lock);
+        size_t before = shard.set.size();
+        shard.set.eraseHashed(t, h);
+        return shard.set.size() != before;
+    }
+
+    /*****************************************
+     * CONCURRENT UNORDERED SET :: RESERVE
+     * Spread the room evenly across the shards
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    void concurrent_unordered_set <T, Hash, KeyEqual> ::reserve(size_t num)
+    {
+        for (size_t i = 0; i < numShards; i++)
+        {
+            WriteLock guard(shards[i].lock);
+            shards[i].set.reserve((num + numShards - 1) / numShards);
+        }
+    }
+
+    /*****************************************
+     * CONCURRENT UNORDERED SET :: CLEAR
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    void concurrent_unordered_set <T, Hash, KeyEqual> ::clear()
+    {
+        for (size_t i = 0; i < numShards; i++)
+        {
+            WriteLock guard(shards[i].lock);
+            shards[i].set.clear();
+        }
+    }
+
+    /*****************************************
+     * CONCURRENT UNORDERED SET :: SIZE
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    size_t concurrent_unordered_set <T, Hash, KeyEqual> ::size() const
+    {
+        size_t num = 0;
+        for (size_t i = 0; i < numShards; i++)
+        {
+            ReadLock guard(shards[i].lock);
+            num += shards[i].set.size();
+        }
+        return num;
+    }
+
+    /*****************************************
+     * CONCURRENT UNORDERED SET :: FOR EACH
+     * Call f(element) on everything, holding each
+     * shard's read lock while we visit it. f must
+     * not call back into this set.
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    template <class F>
+    void concurrent_unordered_set <T, Hash, KeyEqual> ::for_each(F f) const
+    {
+        for (size_t i = 0; i < numShards; i++)
+        {
+            ReadLock guard(shards[i].lock);
+            for (auto it = shards[i].set.begin(); it != shards[i].set.end(); ++it)
+                f(static_cast<const T&>(*it));
+        }
+    }
+
+} // namespace custom
@@ -0,0 +1,334 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT VECTOR
+ * Summary:
+ *    A vector that many threads can append to at once
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        concurrent_vector           : A segmented, append-only vector
+ *        concurrent_vector::iterator : An interator through concurrent_vector
+ *
+ *    The elements live in segments that double in size: segment 0 holds
+ *    8 elements, segment 1 holds 16, and so on. Growing only ever adds a
+ *    segment, so an element never moves and pointers to it stay good.
+ *
+ *    push_back and grow_by may be called from any number of threads.
+ *    An element may be read from another thread once the push_back
+ *    that created it has returned and that thread has seen the index.
+ *    size() counts elements that have been claimed, some of which may
+ *    still be under construction. Everything else (clear, copy, the
+ *    destructor) needs the caller to stop all other threads first.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>           // because I am paranoid
+#include <new>               // for placement new
+#include <memory>            // for std::allocator
+#include <atomic>            // for std::atomic
+#include <utility>           // for std::forward
+#include <initializer_list>  // for std::initializer_list
+
+class TestConcurrentVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************
+     * CONCURRENT VECTOR
+     * Like vector, but push_back is lock-free and
+     * never moves the elements already there
+     ****************************************/
+    template <typename T>
+    class concurrent_vector
+    {
+        friend class ::TestConcurrentVector; // give unit tests access to the privates
+    public:
+
+        //
+        // Construct
+        //
+
+        concurrent_vector() : numElements(0)
+        {
+            for (size_t k = 0; k < numSegments; k++)
+                segments[k].store(nullptr, std::memory_order_relaxed);
+        }
+        concurrent_vector(const std::initializer_list<T>& l) : concurrent_vector()
+        {
+            for (const T& t : l)
+                push_back(t);
+        }
+        concurrent_vector(const concurrent_vector& rhs) : concurrent_vector()
+        {
+            *this = rhs;
+        }
+        ~concurrent_vector()
+        {
+            clear();
+            for (size_t k = 0; k < numSegments; k++)
+            {
+                T* p = segments[k].load(std::memory_order_relaxed);
+                if (p)
+                    std::allocator<T>().deallocate(p, segmentSize(k));
+            }
+        }
+
+        //
+        // Assign
+        //
+
+        concurrent_vector& operator = (const concurrent_vector& rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                for (size_t i = 0; i < rhs.size(); i++)
+                    push_back(rhs[i]);
+            }
+            return *this;
+        }
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator begin() { return iterator(0, this); }
+        iterator end() { return iterator(size(), this); }
+
+        //
+        // Access
+        //
+
+        T& operator [] (size_t index) { return *slot(index); }
+        const T& operator [] (size_t index) const { return *slot(index); }
+        T& front() { return *slot(0); }
+        T& back() { return *slot(size() - 1); }
+
+        //
+        // Insert
+        //
+
+        size_t push_back(const T& t) { return emplace_back(t); }
+        size_t push_back(T&& t) { return emplace_back(std::move(t)); }
+        template <class ... Args>
+        size_t emplace_back(Args&& ... args);
+        size_t grow_by(size_t num, const T& t = T());
+
+        //
+        // Remove
+        //
+
+        void clear();
+
+        //
+        // Status
+        //
+
+        size_t size() const { return numElements.load(std::memory_order_acquire); }
+        bool empty() const { return size() == 0; }
+        size_t capacity() const;
+
+    private:
+
+        static const size_t firstSegment = 8;    // elements in segment 0, a power of two
+        static const size_t numSegments = 48;    // enough for any address space
+
+        static size_t segmentOf(size_t index);
+        static size_t segmentSize(size_t k) { return firstSegment << k; }
+        static size_t segmentStart(size_t k) { return (firstSegment << k) - firstSegment; }
+
+        T* slot(size_t index) const
+        {
+            size_t k = segmentOf(index);
+            return segments[k].load(std::memory_order_acquire) + (index - segmentStart(k));
+        }
+        void allocateSegment(size_t k);
+
+        mutable std::atomic<T*> segments[numSegments];  // each segment is allocated once
+        std::atomic<size_t> numElements;               // number of slots handed out
+    };
+
+    /**************************************************
+     * CONCURRENT VECTOR ITERATOR
+     * An iterator through concurrent_vector. Holds an
+     * index rather than a pointer because the elements
+     * are not contiguous across segments.
+     *************************************************/
+    template <typename T>
+    class concurrent_vector <T> ::iterator
+    {
+        friend class ::TestConcurrentVector; // give unit tests access to the privates
+    public:
+        // constructors, destructors, and assignment operator
+        iterator() : index(0), v(nullptr) {}
+        iterator(size_t index, concurrent_vector<T>* v) : index(index), v(v) {}
+        iterator(const iterator& rhs) : index(rhs.index), v(rhs.v) {}
+        iterator& operator = (const iterator& rhs)
+        {
+            index = rhs.index;
+            v = rhs.v;
+            return *this;
+        }
+
+        // equals, not equals operator
+        bool operator != (const iterator& rhs) const { return rhs.index != index; }
+        bool operator == (const iterator& rhs) const { return rhs.index == index; }
+
+        // dereference operator
+        T& operator * () { return (*v)[index]; }
+
+        // prefix increment
+        iterator& operator ++ ()
+        {
+            index++;
+            return *this;
+        }
+
+        // postfix increment
+        iterator operator ++ (int)
+        {
+            iterator returnCopy(*this);
+            index++;
+            return returnCopy;
+        }
+
+        // prefix decrement
+        iterator& operator -- ()
+        {
+            index--;
+            return *this;
+        }
+
+        // postfix decrement
+        iterator operator -- (int)
+        {
+            iterator returnCopy(*this);
+            index--;
+            return returnCopy;
+        }
+
+    private:
+        size_t index;
+        concurrent_vector<T>* v;
+    };
+
+    /*****************************************
+     * CONCURRENT VECTOR :: SEGMENT OF
+     * Segment k starts at 8 * (2^k - 1), so the
+     * segment is the top bit of index / 8 + 1
+     ****************************************/
+    template <typename T>
+    size_t concurrent_vector <T> ::segmentOf(size_t index)
+    {
+        size_t x = index / firstSegment + 1;
+#if defined(__GNUC__)
+        return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(x);
+#else
+        size_t k = 0;
+        while (x >>= 1)
+            k++;
+        return k;
+#endif
+    }
+
+    /*****************************************
+     * CONCURRENT VECTOR :: ALLOCATE SEGMENT
+     * Several threads may race to allocate the same
+     * segment. One wins the compare-exchange, the rest
+     * give their memory back.
+     ****************************************/
+    template <typename T>
+    void concurrent_vector <T> ::allocateSegment(size_t k)
+    {
+        if (segments[k].load(std::memory_order_acquire))
+            return;
+
+        T* p = std::allocator<T>().allocate(segmentSize(k));
+        T* expected = nullptr;
+        if (!segments[k].compare_exchange_strong(expected, p,
+            std::memory_order_acq_rel, std::memory_order_acquire))
+            std::allocator<T>().deallocate(p, segmentSize(k));
+    }
+
+    /*****************************************
+     * CONCURRENT VECTOR :: EMPLACE BACK
+     * Claim the next index with one atomic add, make
+     * sure its segment exists, and build the element
+     * there. Nothing already in the vector moves.
+     *     INPUT  : args for the constructor of T
+     *     OUTPUT : the index of the new element
+     ****************************************/
+    template <typename T>
+    template <class ... Args>
+    size_t concurrent_vector <T> ::emplace_back(Args&& ... args)
+    {
+        size_t index = numElements.fetch_add(1, std::memory_order_acq_rel);
+        allocateSegment(segmentOf(index));
+        new (slot(index)) T(std::forward<Args>(args)...);
+        return index;
+    }
+
+    /*****************************************
+     * CONCURRENT VECTOR :: GROW BY
+     * Claim num indices at once and copy t into each
+     *     INPUT  : num the number of elements to add
+     *              t the value for each of them
+     *     OUTPUT : the index of the first new element
+     ****************************************/
+    template <typename T>
+    size_t concurrent_vector <T> ::grow_by(size_t num, const T& t)
+    {
+        size_t first = numElements.fetch_add(num, std::memory_order_acq_rel);
+        if (num == 0)
+            return first;
+
+        for (size_t k = segmentOf(first); k <= segmentOf(first + num - 1); k++)
+            allocateSegment(k);
+        for (size_t i = first; i < first + num; i++)
+            new (slot(i)) T(t);
+        return first;
+    }
+
+    /*****************************************
+     * CONCURRENT VECTOR :: CLEAR
+     * Destroy the elements but keep the segments.
+     * Not safe while other threads are appending.
+     ****************************************/
+    template <typename T>
+    void concurrent_vector <T> ::clear()
+    {
+        size_t num = numElements.load(std::memory_order_acquire);
+        for (size_t i = 0; i < num; i++)
+            slot(i)->~T();
+        numElements.store(0, std::memory_order_release);
+    }
+
+    /*****************************************
+     * CONCURRENT VECTOR :: CAPACITY
+     * Elements that fit up to the end of the highest
+     * segment allocated so far. A thread can allocate
+     * a later segment before another thread allocates
+     * an earlier one, so count from the top down.
+     ****************************************/
+    template <typename T>
+    size_t concurrent_vector <T> ::capacity() const
+    {
+        for (size_t k = numSegments; k > 0; k--)
+            if (segments[k - 1].load(std::memory_order_acquire))
+                return segmentStart(k);
+        return 0;
+    }
+
+} // namespace custom
@@ -0,0 +1,256 @@
+/***********************************************************************
+ * Header:
+ *    COW VECTOR
+ * Summary:
+ *    A copy-on-write vector: copies share one buffer until written
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        cow_vector : A vector whose copies are O(1)
+ *
+ *    Copying a cow_vector only bumps an atomic reference count. The first
+ *    call through a non-const member (operator [], push_back, begin, ...)
+ *    on a shared buffer clones it, so the other copies never see the write.
+ *    Reading through a const cow_vector never clones.
+ *
+ *    Handing out a reference or iterator through a non-const member
+ *    (operator [], front, back, begin, end) marks the buffer unshareable:
+ *    from then on a copy gets its own buffer, so a write through that
+ *    reference never shows up in the copy. clear() makes it shareable again.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <atomic>       // for std::atomic
+#include <utility>      // for std::move
+#include "vector.h"     // the shared buffer is a vector
+
+class TestCowVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************
+     * COW VECTOR
+     * Same interface as custom::vector <T>, with
+     * the buffer shared between copies
+     ****************************************/
+    template <typename T>
+    class cow_vector
+    {
+        friend class ::TestCowVector; // give unit tests access to the privates
+    public:
+        using iterator = typename vector<T>::iterator;
+
+        //
+        // Construct
+        //
+
+        cow_vector() : pBlock(new Block()) {}
+        cow_vector(size_t num) : pBlock(new Block(vector<T>(num))) {}
+        cow_vector(size_t num, const T& t) : pBlock(new Block(vector<T>(num, t))) {}
+        cow_vector(const std::initializer_list<T>& l) : pBlock(new Block(vector<T>(l))) {}
+        cow_vector(const vector<T>& rhs) : pBlock(new Block(rhs)) {}
+        cow_vector(const cow_vector& rhs) : pBlock(nullptr) { share(rhs); }
+        cow_vector(cow_vector&& rhs) : pBlock(rhs.pBlock) { rhs.pBlock = nullptr; }
+        ~cow_vector() { release(); }
+
+        //
+        // Assign
+        //
+
+        cow_vector& operator = (const cow_vector& rhs)
+        {
+            if (pBlock != rhs.pBlock)
+            {
+                release();
+                share(rhs);
+            }
+            return *this;
+        }
+        cow_vector& operator = (cow_vector&& rhs)
+        {
+            if (this != &rhs)
+            {
+                release();
+                pBlock = rhs.pBlock;
+                rhs.pBlock = nullptr;
+            }
+            return *this;
+        }
+        void swap(cow_vector& rhs)
+        {
+            Block* temp = rhs.pBlock;
+            rhs.pBlock = pBlock;
+            pBlock = temp;
+        }
+
+        //
+        // Iterator
+        //
+
+        iterator begin() { return leak().begin(); }
+        iterator end() { return leak().end(); }
+
+        //
+        // Access
+        //
+
+        T& operator [] (size_t index) { return leak()[index]; }
+        const T& operator [] (size_t index) const { return read()[index]; }
+        T& front() { return leak().front(); }
+        const T& front() const { return read().front(); }
+        T& back() { return leak().back(); }
+        const T& back() const { return read().back(); }
+
+        //
+        // Insert
+        //
+
+        void push_back(const T& t) { write().push_back(t); }
+        void push_back(T&& t) { write().push_back(std::move(t)); }
+        void reserve(size_t newCapacity) { write().reserve(newCapacity); }
+        void resize(size_t newElements) { write().resize(newElements); }
+        void resize(size_t newElements, const T& t) { write().resize(newElements, t); }
+
+        //
+        // Remove
+        //
+
+        void clear();
+        void pop_back() { write().pop_back(); }
+        void shrink_to_fit() { write().shrink_to_fit(); }
+
+        //
+        // Status
+        //
+
+        size_t size()      const { return read().size(); }
+        size_t capacity()  const { return read().capacity(); }
+        bool empty()       const { return read().empty(); }
+        size_t use_count() const { return pBlock ? pBlock->refs.load(std::memory_order_acquire) : 0; }
+
+    private:
+
+        // the shared part: the elements and how many cow_vectors point here
+        struct Block
+        {
+            Block() : refs(1), shareable(true) {}
+            Block(const vector<T>& items) : refs(1), shareable(true), items(items) {}
+            Block(vector<T>&& items) : refs(1), shareable(true), items(std::move(items)) {}
+
+            std::atomic<size_t> refs;
+            bool shareable;       // false once a T& or iterator has been handed out
+            vector<T> items;
+        };
+
+        void addRef() { pBlock->refs.fetch_add(1, std::memory_order_relaxed); }
+        void share(const cow_vector& rhs);
+        void release();
+        const vector<T>& read() const;
+        vector<T>& write();
+        vector<T>& leak()
+        {
+            vector<T>& items = write();
+            pBlock->shareable = false;
+            return items;
+        }
+
+        Block* pBlock;    // shared with every copy until one of them writes
+    };
+
+    /*****************************************
+     * COW VECTOR :: SHARE
+     * Point at the buffer of rhs, or at a copy of
+     * it if rhs has handed out references into it.
+     * *this must not hold a buffer.
+     ****************************************/
+    template <typename T>
+    void cow_vector <T> ::share(const cow_vector& rhs)
+    {
+        if (rhs.pBlock && !rhs.pBlock->shareable)
+            pBlock = new Block(rhs.pBlock->items);
+        else
+        {
+            pBlock = rhs.pBlock;
+            if (pBlock)
+                addRef();
+        }
+    }
+
+    /*****************************************
+     * COW VECTOR :: RELEASE
+     * Drop our reference; the last one out
+     * deletes the buffer
+     ****************************************/
+    template <typename T>
+    void cow_vector <T> ::release()
+    {
+        if (pBlock && pBlock->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete pBlock;
+        pBlock = nullptr;
+    }
+
+    /*****************************************
+     * COW VECTOR :: READ
+     * The elements, for reading only. A moved-from
+     * cow_vector reads as empty.
+     ****************************************/
+    template <typename T>
+    const vector<T>& cow_vector <T> ::read() const
+    {
+        static const vector<T> empty;
+        return pBlock ? pBlock->items : empty;
+    }
+
+    /*****************************************
+     * COW VECTOR :: WRITE
+     * The elements, for writing. If anyone else
+     * shares the buffer, clone it first.
+     ****************************************/
+    template <typename T>
+    vector<T>& cow_vector <T> ::write()
+    {
+        if (pBlock == nullptr)
+            pBlock = new Block();
+        else if (pBlock->refs.load(std::memory_order_acquire) != 1)
+        {
+            Block* pClone = new Block(pBlock->items);
+            release();
+            pBlock = pClone;
+        }
+        return pBlock->items;
+    }
+
+    /*****************************************
+     * COW VECTOR :: CLEAR
+     * A shared buffer is simply let go rather
+     * than cloned and then emptied. Every reference
+     * into it is gone, so it can be shared again.
+     ****************************************/
+    template <typename T>
+    void cow_vector <T> ::clear()
+    {
+        if (pBlock && pBlock->refs.load(std::memory_order_acquire) != 1)
+        {
+            release();
+            pBlock = new Block();
+        }
+        else
+        {
+            write().clear();
+            pBlock->shareable = true;
+        }
+    }
+
+} // namespace custom
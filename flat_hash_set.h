@@ -0,0 +1,615 @@
+/***********************************************************************
+ * Header:
+ *    FLAT HASH SET
+ * Summary:
+ *    An open-addressing hash set that probes 16 slots at a time
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        flat_hash_set           : A Swiss-table style hash set
+ *        flat_hash_set::iterator : An interator through flat_hash_set
+ *
+ *    The elements sit in one flat array of slots, split into groups of
+ *    16. Next to the slots is one control byte per slot: EMPTY, DELETED,
+ *    or, for a full slot, the low 7 bits of the element's hash. A lookup
+ *    picks a group from the rest of the hash and compares all 16 control
+ *    bytes against those 7 bits at once with SSE2, so it usually touches
+ *    just the one element that matches. It stops at the first group with
+ *    an EMPTY byte.
+ *
+ *    Erasing from a group that still has an EMPTY slot leaves EMPTY, not
+ *    a DELETED tombstone: no lookup can have probed past such a group.
+ *    The table grows when it is 7/8 full, counting tombstones.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // because I am paranoid
+#include <cstdint>     // for int8_t
+#include <cstring>     // for memset
+#include <memory>      // for std::allocator
+#include <functional>  // for std::hash and std::equal_to
+#include <utility>     // for std::move
+#include "pair.h"      // for pair
+
+#if !defined(CUSTOM_SIMD_DISABLE) && (defined(__x86_64__) || defined(_M_X64))
+#ifndef CUSTOM_SIMD_X86
+#define CUSTOM_SIMD_X86
+#endif
+#include <emmintrin.h> // for the SSE2 intrinsics
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>    // for _BitScanForward
+#endif
+
+class TestFlatHashSet; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /************************************************
+     * FLAT HASH SET
+     * A set implemented as an open-addressing hash
+     ************************************************/
+    template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+    class flat_hash_set
+    {
+        friend class ::TestFlatHashSet; // give unit tests access to the privates
+    public:
+        //
+        // Construct
+        //
+        flat_hash_set() : ctrl(nullptr), slots(nullptr), numSlots(0), numElements(0), growthLeft(0) {}
+        flat_hash_set(const flat_hash_set& rhs) : flat_hash_set()
+        {
+            *this = rhs;
+        }
+        flat_hash_set(flat_hash_set&& rhs) : flat_hash_set()
+        {
+            swap(rhs);
+        }
+        template <class Iterator>
+        flat_hash_set(Iterator first, Iterator last) : flat_hash_set()
+        {
+            for (auto it = first; it != last; ++it)
+                insert(*it);
+        }
+        flat_hash_set(const std::initializer_list<T>& il) : flat_hash_set()
+        {
+            reserve(il.size());
+            insert(il);
+        }
+        ~flat_hash_set()
+        {
+            clear();
+            deallocate();
+        }
+
+        //
+        // Assign
+        //
+        flat_hash_set& operator = (const flat_hash_set& rhs);
+        flat_hash_set& operator = (flat_hash_set&& rhs)
+        {
+            clear();
+            swap(rhs);
+            return *this;
+        }
+        flat_hash_set& operator = (const std::initializer_list<T>& il)
+        {
+            clear();
+            reserve(il.size());
+            insert(il);
+            return *this;
+        }
+        void swap(flat_hash_set& rhs)
+        {
+            std::swap(ctrl, rhs.ctrl);
+            std::swap(slots, rhs.slots);
+            std::swap(numSlots, rhs.numSlots);
+            std::swap(numElements, rhs.numElements);
+            std::swap(growthLeft, rhs.growthLeft);
+            std::swap(hasher, rhs.hasher);
+            std::swap(equal, rhs.equal);
+        }
+
+        //
+        // Iterator
+        //
+        class iterator;
+        iterator begin() const;
+        iterator end() const;
+
+        //
+        // Access
+        //
+        iterator find(const T& t) const;
+        size_t count(const T& t) const { return findIndex(t) == numSlots ? 0 : 1; }
+        bool contains(const T& t) const { return findIndex(t) != numSlots; }
+
+        //
+        // Insert
+        //
+        custom::pair<iterator, bool> insert(const T& t) { return emplace(t); }
+        custom::pair<iterator, bool> insert(T&& t) { return emplace(std::move(t)); }
+        template <class U>
+        custom::pair<iterator, bool> emplace(U&& t);
+        void insert(const std::initializer_list<T>& il)
+        {
+            for (const T& t : il)
+                insert(t);
+        }
+        void rehash(size_t num);
+        void reserve(size_t num) { rehash(num); }
+
+        //
+        // Remove
+        //
+        void clear();
+        iterator erase(const T& t);
+        iterator erase(iterator it);
+
+        //
+        // Status
+        //
+        size_t size()         const { return numElements; }
+        bool empty()          const { return numElements == 0; }
+        size_t bucket_count() const { return numSlots; }
+        float load_factor()   const { return numSlots ? float(numElements) / float(numSlots) : 0.0f; }
+        float max_load_factor() const { return 0.875f; }
+
+    private:
+
+        // control bytes; a full slot holds the low 7 bits of its hash
+        static const int8_t EMPTY = -128;
+        static const int8_t DELETED = -2;
+        static const size_t GROUP = 16;
+
+        struct Group;
+
+        static size_t mix(size_t h);
+        static size_t lowestBit(unsigned mask);
+        static size_t capacityFor(size_t num);
+        static size_t growthFor(size_t numSlots) { return numSlots - numSlots / 8; }
+
+        size_t hashOf(const T& t) const { return mix(hasher(t)); }
+        size_t groupMask() const { return numSlots / GROUP - 1; }
+        size_t findIndex(const T& t) const;
+        size_t findFree(size_t h) const;
+        size_t nextFull(size_t index) const;
+        void eraseIndex(size_t index);
+        void allocate(size_t num);
+        void deallocate();
+
+        int8_t* ctrl;         // one control byte per slot
+        T* slots;             // uninitialized unless the control byte is full
+        size_t numSlots;      // 0 or a power of two, at least GROUP
+        size_t numElements;   // the number of full slots
+        size_t growthLeft;    // inserts into EMPTY slots left before we must grow
+        Hash hasher;
+        KeyEqual equal;
+    };
+
+    /************************************************
+     * FLAT HASH SET GROUP
+     * 16 control bytes and the slots that match
+     * a test, as a bit mask
+     ************************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    struct flat_hash_set <T, Hash, KeyEqual> ::Group
+    {
+#ifdef CUSTOM_SIMD_X86
+        explicit Group(const int8_t* p) : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+        unsigned match(int8_t h2) const
+        {
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h2)));
+        }
+        unsigned matchEmpty() const
+        {
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(EMPTY)));
+        }
+        unsigned matchFree() const   // EMPTY or DELETED: the sign bit is set
+        {
+            return _mm_movemask_epi8(bytes);
+        }
+
+        __m128i bytes;
+#else
+        explicit Group(const int8_t* p) : p(p) {}
+
+        unsigned match(int8_t h2) const
+        {
+            unsigned mask = 0;
+            for (size_t i = 0; i < GROUP; i++)
+                if (p[i] == h2)
+                    mask |= 1u << i;
+            return mask;
+        }
+        unsigned matchEmpty() const { return match(EMPTY); }
+        unsigned matchFree() const
+        {
+            unsigned mask = 0;
+            for (size_t i = 0; i < GROUP; i++)
+                if (p[i] < 0)
+                    mask |= 1u << i;
+            return mask;
+        }
+
+        const int8_t* p;
+#endif
+        unsigned matchFull() const { return ~matchFree() & 0xFFFF; }
+    };
+
+    /************************************************
+     * FLAT HASH SET ITERATOR
+     * Walks the full slots in order
+     ************************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    class flat_hash_set <T, Hash, KeyEqual> ::iterator
+    {
+        friend class ::TestFlatHashSet; // give unit tests access to the privates
+        friend class flat_hash_set;
+    public:
+        // constructors, destructors, and assignment operator
+        iterator() : index(0), pSet(nullptr) {}
+        iterator(size_t index, const flat_hash_set* pSet) : index(index), pSet(pSet) {}
+
+        // equals, not equals operator
+        bool operator != (const iterator& rhs) const { return rhs.index != index; }
+        bool operator == (const iterator& rhs) const { return rhs.index == index; }
+
+        // dereference operator
+        const T& operator * () const { return pSet->slots[index]; }
+        const T* operator -> () const { return pSet->slots + index; }
+
+        // prefix increment
+        iterator& operator ++ ()
+        {
+            index = pSet->nextFull(index + 1);
+            return *this;
+        }
+
+        // postfix increment
+        iterator operator ++ (int)
+        {
+            iterator returnCopy(*this);
+            ++(*this);
+            return returnCopy;
+        }
+
+    private:
+        size_t index;               // which slot we are on; numSlots at the end
+        const flat_hash_set* pSet;
+    };
+
+    template <typename T, typename Hash, typename KeyEqual>
+    typename flat_hash_set <T, Hash, KeyEqual> ::iterator flat_hash_set <T, Hash, KeyEqual> ::begin() const
+    {
+        return iterator(nextFull(0), this);
+    }
+
+    template <typename T, typename Hash, typename KeyEqual>
+    typename flat_hash_set <T, Hash, KeyEqual> ::iterator flat_hash_set <T, Hash, KeyEqual> ::end() const
+    {
+        return iterator(numSlots, this);
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: MIX
+     * std::hash of an integer is the integer itself,
+     * so spread its bits before we split off the
+     * 7 control bits
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    size_t flat_hash_set <T, Hash, KeyEqual> ::mix(size_t h)
+    {
+        uint64_t x = static_cast<uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(x ^ (x >> 32));
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: LOWEST BIT
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    size_t flat_hash_set <T, Hash, KeyEqual> ::lowestBit(unsigned mask)
+    {
+        assert(mask != 0);
+#if defined(__GNUC__)
+        return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return index;
+#else
+        size_t i = 0;
+        while (!(mask & 1))
+        {
+            mask >>= 1;
+            i++;
+        }
+        return i;
+#endif
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: CAPACITY FOR
+     * The smallest power of two number of slots
+     * that holds num elements at 7/8 full
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    size_t flat_hash_set <T, Hash, KeyEqual> ::capacityFor(size_t num)
+    {
+        size_t capacity = GROUP;
+        while (growthFor(capacity) < num)
+            capacity *= 2;
+        return capacity;
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: FIND INDEX
+     * The slot holding t, or numSlots if none does.
+     * Probe group after group until one has an EMPTY.
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    size_t flat_hash_set <T, Hash, KeyEqual> ::findIndex(const T& t) const
+    {
+        if (numSlots == 0)
+            return numSlots;
+
+        size_t h = hashOf(t);
+        int8_t h2 = static_cast<int8_t>(h & 0x7F);
+        size_t iGroup = (h >> 7) & groupMask();
+        for (size_t step = 1; ; step++)
+        {
+            Group group(ctrl + iGroup * GROUP);
+            for (unsigned mask = group.match(h2); mask; mask &= mask - 1)
+            {
+                size_t index = iGroup * GROUP + lowestBit(mask);
+                if (equal(slots[index], t))
+                    return index;
+            }
+            if (group.matchEmpty())
+                return numSlots;
+            iGroup = (iGroup + step) & groupMask();
+        }
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: FIND FREE
+     * The first EMPTY or DELETED slot along the
+     * probe sequence for hash h
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    size_t flat_hash_set <T, Hash, KeyEqual> ::findFree(size_t h) const
+    {
+        size_t iGroup = (h >> 7) & groupMask();
+        for (size_t step = 1; ; step++)
+        {
+            unsigned mask = Group(ctrl + iGroup * GROUP).matchFree();
+            if (mask)
+                return iGroup * GROUP + lowestBit(mask);
+            iGroup = (iGroup + step) & groupMask();
+        }
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: NEXT FULL
+     * The first full slot at or after index,
+     * a group at a time
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    size_t flat_hash_set <T, Hash, KeyEqual> ::nextFull(size_t index) const
+    {
+        while (index < numSlots)
+        {
+            size_t iStart = index & ~(GROUP - 1);
+            unsigned mask = Group(ctrl + iStart).matchFull() >> (index - iStart);
+            if (mask)
+                return index + lowestBit(mask);
+            index = iStart + GROUP;
+        }
+        return numSlots;
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: FIND
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    typename flat_hash_set <T, Hash, KeyEqual> ::iterator flat_hash_set <T, Hash, KeyEqual> ::find(const T& t) const
+    {
+        return iterator(findIndex(t), this);
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: EMPLACE
+     * Insert t unless it is already there. Grow
+     * first if there is no EMPTY slot to spare.
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    template <class U>
+    custom::pair<typename flat_hash_set <T, Hash, KeyEqual> ::iterator, bool>
+        flat_hash_set <T, Hash, KeyEqual> ::emplace(U&& t)
+    {
+        size_t index = findIndex(t);
+        if (index != numSlots)
+            return custom::pair<iterator, bool>(iterator(index, this), false);
+
+        // out of room: grow, or just sweep out the tombstones
+        if (growthLeft == 0)
+            rehash(numElements + 1 > growthFor(numSlots) / 2 ? growthFor(numSlots * 2) : numElements);
+
+        size_t h = hashOf(t);
+        index = findFree(h);
+        if (ctrl[index] == EMPTY)
+            growthLeft--;
+        ctrl[index] = static_cast<int8_t>(h & 0x7F);
+        new (static_cast<void*>(slots + index)) T(std::forward<U>(t));
+        numElements++;
+        return custom::pair<iterator, bool>(iterator(index, this), true);
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: ERASE INDEX
+     * Leave EMPTY if the group still has an EMPTY
+     * slot; otherwise a probe may have passed
+     * through here, so leave a tombstone
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    void flat_hash_set <T, Hash, KeyEqual> ::eraseIndex(size_t index)
+    {
+        slots[index].~T();
+        numElements--;
+
+        if (Group(ctrl + (index & ~(GROUP - 1))).matchEmpty())
+        {
+            ctrl[index] = EMPTY;
+            growthLeft++;
+        }
+        else
+            ctrl[index] = DELETED;
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: ERASE
+     * Remove one element
+     *     OUTPUT : iterator to the element after it
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    typename flat_hash_set <T, Hash, KeyEqual> ::iterator flat_hash_set <T, Hash, KeyEqual> ::erase(const T& t)
+    {
+        size_t index = findIndex(t);
+        if (index == numSlots)
+            return end();
+        eraseIndex(index);
+        return iterator(nextFull(index + 1), this);
+    }
+
+    template <typename T, typename Hash, typename KeyEqual>
+    typename flat_hash_set <T, Hash, KeyEqual> ::iterator flat_hash_set <T, Hash, KeyEqual> ::erase(iterator it)
+    {
+        if (it.index == numSlots)
+            return end();
+        eraseIndex(it.index);
+        return iterator(nextFull(it.index + 1), this);
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: CLEAR
+     * Destroy every element but keep the slots
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    void flat_hash_set <T, Hash, KeyEqual> ::clear()
+    {
+        for (size_t i = nextFull(0); i < numSlots; i = nextFull(i + 1))
+            slots[i].~T();
+        if (numSlots)
+            memset(ctrl, EMPTY, numSlots);
+        numElements = 0;
+        growthLeft = growthFor(numSlots);
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: ALLOCATE and DEALLOCATE
+     * Fresh slots are all EMPTY
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    void flat_hash_set <T, Hash, KeyEqual> ::allocate(size_t num)
+    {
+        ctrl = new int8_t[num];
+        memset(ctrl, EMPTY, num);
+        slots = std::allocator<T>().allocate(num);
+        numSlots = num;
+        growthLeft = growthFor(num);
+    }
+
+    template <typename T, typename Hash, typename KeyEqual>
+    void flat_hash_set <T, Hash, KeyEqual> ::deallocate()
+    {
+        if (numSlots)
+        {
+            delete [] ctrl;
+            std::allocator<T>().deallocate(slots, numSlots);
+        }
+        ctrl = nullptr;
+        slots = nullptr;
+        numSlots = 0;
+        growthLeft = 0;
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: REHASH
+     * Move everything into a table big enough for
+     * num elements (and at least size()). Dropping
+     * the tombstones is a side effect.
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    void flat_hash_set <T, Hash, KeyEqual> ::rehash(size_t num)
+    {
+        if (num < numElements)
+            num = numElements;
+        size_t newSlots = capacityFor(num);
+        if (newSlots == numSlots && growthLeft + numElements == growthFor(numSlots))
+            return;   // already the right size and no tombstones
+
+        int8_t* oldCtrl = ctrl;
+        T* oldSlots = slots;
+        size_t oldNumSlots = numSlots;
+
+        allocate(newSlots);
+        for (size_t i = 0; i < oldNumSlots; i++)
+            if (oldCtrl[i] >= 0)
+            {
+                size_t h = hashOf(oldSlots[i]);
+                size_t index = findFree(h);
+                ctrl[index] = static_cast<int8_t>(h & 0x7F);
+                new (static_cast<void*>(slots + index)) T(std::move(oldSlots[i]));
+                oldSlots[i].~T();
+                growthLeft--;
+            }
+
+        if (oldNumSlots)
+        {
+            delete [] oldCtrl;
+            std::allocator<T>().deallocate(oldSlots, oldNumSlots);
+        }
+    }
+
+    /*****************************************
+     * FLAT HASH SET :: ASSIGNMENT
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    flat_hash_set <T, Hash, KeyEqual>& flat_hash_set <T, Hash, KeyEqual> ::operator = (const flat_hash_set& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        clear();
+        hasher = rhs.hasher;
+        equal = rhs.equal;
+        reserve(rhs.size());
+        for (const T& t : rhs)
+            insert(t);
+        return *this;
+    }
+
+    /*****************************************
+     * SWAP
+     * Stand-alone flat hash set swap
+     ****************************************/
+    template <typename T, typename Hash, typename KeyEqual>
+    void swap(flat_hash_set <T, Hash, KeyEqual>& lhs, flat_hash_set <T, Hash, KeyEqual>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace custom
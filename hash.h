@@ -11,8 +11,58 @@
  *    |_____|  '.____.'   '.____.'  /_/
  *
  *    This will contain the class definition of:
+ *        hash_table              : The buckets, shared with unordered_map
+ *        hash_table::iterator    : An interator through hash
  *        unordered_set           : A class that represents a hash
- *        unordered_set::iterator : An interator through hash
+ *
+ *    The buckets live in an array on the heap. When an insert would push
+ *    the load factor past max_load_factor(), the array doubles and every
+ *    element is moved to its new bucket, so chains stay short at any size.
+ *
+ *    With incremental_rehash(true), growing does not move everything at
+ *    once. The old array is kept next to the new one, and every insert
+ *    of a new key and every erase migrates a few old buckets, so no single
+ *    call pays for the whole table. find looks in both arrays until the
+ *    migration is done but never moves anything, so lookups are const and
+ *    leave iterators alone. Like rehash, a migration step invalidates
+ *    iterators.
+ *
+ *    When both Hash and KeyEqual declare is_transparent, find, count,
+ *    contains and erase take any key type they accept, so a set of
+ *    std::string can be searched with a std::string_view or a const char*
+ *    without building a temporary string.
+ *
+ *    For keys whose hash is expensive (anything that is not a number,
+ *    enum or pointer) each bucket entry also keeps the full hash. Walking
+ *    a chain then compares hashes before keys, and a rehash never calls
+ *    the hasher. Specialize cache_hash_code to choose otherwise.
+ *
+ *    Next to each bucket array is a bitmap with one bit per bucket, set
+ *    while the bucket is not empty. begin(), ++, clear and the migration
+ *    skip empty buckets 64 at a time by counting trailing zeros, so a
+ *    sparse table iterates at the speed of a full one.
+ *
+ *    With bloom_filter(true), a blocked Bloom filter of every element's
+ *    hash sits in front of the buckets. Most lookups of a missing key stop
+ *    at one cache line of the filter and never walk a chain. Inserts add
+ *    to it; growing the table, or erasing a quarter as many elements as
+ *    remain, rebuilds it.
+ *
+ *    insert(first, last) reserves room for the whole range once, then
+ *    works through it 16 elements at a time: hash them all, prefetch
+ *    their buckets and the first entry of each chain, and only then
+ *    insert. The cache misses of a batch overlap instead of waiting on
+ *    each other. The range and initializer_list constructors use it.
+ *
+ *    A bucket is hash % bucket_count() unless the Hash names a faster
+ *    index_policy, as the well-mixed hashes in hashing.h do: fastrange
+ *    takes the bucket from the high bits with one multiply, and
+ *    mask_index keeps the bucket count a power of two and masks.
+ *
+ *    stats() reports the load factor and the shape of the chains. Define
+ *    CUSTOM_HASH_STATS to also count the probes of every lookup and the
+ *    number and duration of rehashes; without it the counters and the
+ *    calls that bump them compile to nothing.
  * Author
  *    <your names here>
  ************************************************************************/
@@ -20,81 +70,262 @@
 #pragma once
 
 #include "list.h"     // because this->buckets[0] is a list
+#include "pair.h"     // for pair
+#include "bloom_filter.h" // for blocked_bloom_filter
+#include "hashing.h"  // for the bucket index policies
+#include <cassert>    // because I am paranoid
 #include <memory>     // for std::allocator
-#include <functional> // for std::hash
+#include <functional> // for std::hash and std::equal_to
+#include <type_traits> // for std::enable_if
 #include <cmath>      // for std::ceil
+#include <cstdint>    // for uint64_t
+#include <algorithm>  // for std::fill_n and std::max
+#ifdef _MSC_VER
+#include <intrin.h>   // for _BitScanForward64 and _mm_prefetch
+#endif
+#ifdef CUSTOM_HASH_STATS
+#include <atomic>     // for std::atomic
+#include <chrono>     // for std::chrono::steady_clock
+#endif
 
 
 class TestHash;             // forward declaration for Hash unit tests
 
 namespace custom
 {
+    template <typename T, typename Hash, typename KeyEqual>
+    class concurrent_unordered_set;
+
     /************************************************
-     * UNORDERED SET
-     * A set implemented as a hash
+     * IS TRANSPARENT
+     * True when both Hash and KeyEqual accept keys
+     * of other types, as std::less<> does
+     ************************************************/
+    template <class ... Ts>
+    struct voider
+    {
+        typedef void type;
+    };
+    template <class Hash, class KeyEqual, class = void>
+    struct is_transparent : std::false_type {};
+    template <class Hash, class KeyEqual>
+    struct is_transparent <Hash, KeyEqual, typename voider<typename Hash::is_transparent,
+                                                          typename KeyEqual::is_transparent>::type> : std::true_type {};
+
+    /************************************************
+     * BUCKET INDEX POLICY
+     * How a hash becomes a bucket: whatever the
+     * Hash asks for with a nested index_policy,
+     * otherwise hash % bucket_count()
+     ************************************************/
+    template <class Hash, class = void>
+    struct bucket_index_policy
+    {
+        typedef modulo_index type;
+    };
+    template <class Hash>
+    struct bucket_index_policy <Hash, typename voider<typename Hash::index_policy>::type>
+    {
+        typedef typename Hash::index_policy type;
+    };
+
+    /************************************************
+     * CACHE HASH CODE
+     * Whether hash_table keeps each element's hash
+     * beside it. Hashing a number is nearly free;
+     * hashing a string is not.
+     ************************************************/
+    template <class T, class Hash>
+    struct cache_hash_code : std::integral_constant<bool,
+        !(std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value)> {};
+
+    /************************************************
+     * KEY OF
+     * How the hash table finds the key in a value:
+     * a set's value is its own key, and a map's
+     * key is the first half of the pair
+     ************************************************/
+    struct key_of_value
+    {
+        template <class T>
+        const T& operator () (const T& value) const { return value; }
+    };
+    struct key_of_pair
+    {
+        template <class P>
+        auto operator () (const P& value) const -> decltype((value.first)) { return value.first; }
+    };
+
+    /************************************************
+     * HASH ENTRY
+     * One element in a bucket, with its hash
+     * when the hash is worth keeping
      ************************************************/
+    template <typename T, bool CacheHash>
+    struct hash_entry
+    {
+        hash_entry() : hash(0) {}
+        hash_entry(const T& value, size_t hash) : value(value), hash(hash) {}
+
+        T value;
+        size_t hash;
+    };
     template <typename T>
-    class unordered_set
+    struct hash_entry <T, false>
+    {
+        hash_entry() {}
+        hash_entry(const T& value, size_t) : value(value) {}
+
+        T value;
+    };
+
+    /************************************************
+     * HASH STATS
+     * A snapshot of how well a hash table is doing.
+     * The lookup and rehash counts stay zero unless
+     * CUSTOM_HASH_STATS is defined.
+     ************************************************/
+    struct hash_stats
+    {
+        static const size_t HISTOGRAM = 16;
+
+        size_t size;                // elements
+        size_t bucketCount;         // buckets, counting the old ones not yet migrated
+        float loadFactor;
+        size_t maxChain;            // the longest bucket
+        float meanChain;            // the mean length of the non-empty buckets
+        size_t chainLengths[HISTOGRAM]; // buckets with 0, 1, 2 ... elements; the last has the rest
+
+        size_t hits;                // lookups that found their key
+        size_t misses;              // lookups that did not
+        float hitProbes;            // keys compared per hit
+        float missProbes;           // keys compared per miss
+        size_t rehashes;            // times the bucket array was replaced
+        double rehashSeconds;       // time spent moving elements to a new array
+    };
+
+    /************************************************
+     * HASH TABLE
+     * The engine under unordered_set and unordered_map.
+     * The buckets hold Values; KeyOf gets the Key
+     * out of a Value, and only the Key is hashed
+     * and compared.
+     ************************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    class hash_table
     {
         friend class ::TestHash;   // give unit tests access to the privates
+        template <typename, typename, typename>
+        friend class concurrent_unordered_set;   // hashes once to pick a shard and a bucket
+
+        typedef hash_entry<Value, cache_hash_code<Key, Hash>::value> Entry;
+        typedef custom::list<Entry> Bucket;
+        typedef typename bucket_index_policy<Hash>::type IndexPolicy;
     public:
         //
         // Construct
         //
-        unordered_set() : numElements(0)
+        hash_table(size_t numBuckets = 8, const Hash& hasher = Hash(), const KeyEqual& equal = KeyEqual()) :
+            buckets(new Bucket[IndexPolicy::bucket_count(numBuckets ? numBuckets : 1)]),
+            occupied(newBits(IndexPolicy::bucket_count(numBuckets ? numBuckets : 1))),
+            numBuckets(IndexPolicy::bucket_count(numBuckets ? numBuckets : 1)),
+            numElements(0), maxLoadFactor(1.0f),
+            oldBuckets(nullptr), oldOccupied(nullptr), numOldBuckets(0), iMigrate(0), incremental(false),
+            filtered(false), numErased(0), hasher(hasher), equal(equal)
         {
         }
-        unordered_set(unordered_set& rhs) : numElements(rhs.numElements)
+        hash_table(hash_table& rhs) : hash_table(rhs.numBuckets, rhs.hasher, rhs.equal)
         {
             *this = rhs;
         }
-        unordered_set(unordered_set&& rhs) : numElements(std::move(numElements))
+        hash_table(hash_table&& rhs) : buckets(rhs.buckets), occupied(rhs.occupied),
+            numBuckets(rhs.numBuckets), numElements(rhs.numElements), maxLoadFactor(rhs.maxLoadFactor),
+            oldBuckets(rhs.oldBuckets), oldOccupied(rhs.oldOccupied),
+            numOldBuckets(rhs.numOldBuckets), iMigrate(rhs.iMigrate),
+            incremental(rhs.incremental), filtered(rhs.filtered), numErased(rhs.numErased),
+            hasher(rhs.hasher), equal(rhs.equal)
         {
-
-            *this = std::move(rhs);
+            filter.swap(rhs.filter);
+            rhs.filtered = false;
+#ifdef CUSTOM_HASH_STATS
+            counters = rhs.counters;
+#endif
+            rhs.buckets = nullptr;
+            rhs.occupied = nullptr;
+            rhs.numBuckets = 0;
+            rhs.numElements = 0;
+            rhs.oldBuckets = nullptr;
+            rhs.oldOccupied = nullptr;
+            rhs.numOldBuckets = 0;
+            rhs.iMigrate = 0;
         }
         template <class Iterator>
-        unordered_set(Iterator first, Iterator last)
+        hash_table(Iterator first, Iterator last) : hash_table()
         {
-            numElements = 0;
-            for (auto it = first; it != last; it++) {
-                insert(*it);
-            }
+            insert(first, last);
         }
+        hash_table(const std::initializer_list<Value>& il) : hash_table()
+        {
+            insert(il.begin(), il.end());
+        }
+        ~hash_table()
+        {
+            clear();
+            delete [] buckets;
+            delete [] occupied;
+        }
+
         //
         // Assign
         //
-        unordered_set& operator=(unordered_set& rhs)
+        hash_table& operator=(hash_table& rhs)
         {
+            if (this == &rhs)
+                return *this;
+
             clear();
-            for (int i = 0; i < 10; i++)
-            {
-                if (!rhs.buckets[i].empty())
-                    for (auto it = rhs.buckets[i].begin(); it != rhs.buckets[i].end(); it++)
-                        insert((*it));
-            }
+            maxLoadFactor = rhs.maxLoadFactor;
+            incremental = rhs.incremental;
+            hasher = rhs.hasher;
+            equal = rhs.equal;
+            bloom_filter(rhs.filtered);
+            reserve(rhs.numElements);
+            for (auto it = rhs.begin(); it != rhs.end(); ++it)
+                insert(*it);
             return *this;
         }
-
-        unordered_set& operator=(unordered_set&& rhs)
+        hash_table& operator=(hash_table&& rhs)
         {
-            numElements = rhs.numElements;
-            for (int i = 0; i < 10; i++) {
-                buckets[i] = std::move(rhs.buckets[i]);
-            }
-
-            rhs.clear();
+            clear();
+            swap(rhs);
             return *this;
         }
-        unordered_set& operator=(const std::initializer_list<T>& il)
+        hash_table& operator=(const std::initializer_list<Value>& il)
         {
+            clear();
+            insert(il.begin(), il.end());
             return *this;
         }
-        void swap(unordered_set& rhs)
+        void swap(hash_table& rhs)
         {
+            std::swap(buckets, rhs.buckets);
+            std::swap(occupied, rhs.occupied);
+            std::swap(numBuckets, rhs.numBuckets);
             std::swap(numElements, rhs.numElements);
-            for (int i = 0; i < 10; i++)
-                buckets[i].swap(rhs.buckets[i]);
+            std::swap(maxLoadFactor, rhs.maxLoadFactor);
+            std::swap(oldBuckets, rhs.oldBuckets);
+            std::swap(oldOccupied, rhs.oldOccupied);
+            std::swap(numOldBuckets, rhs.numOldBuckets);
+            std::swap(iMigrate, rhs.iMigrate);
+            std::swap(incremental, rhs.incremental);
+            filter.swap(rhs.filter);
+            std::swap(filtered, rhs.filtered);
+            std::swap(numErased, rhs.numErased);
+            std::swap(hasher, rhs.hasher);
+            std::swap(equal, rhs.equal);
+#ifdef CUSTOM_HASH_STATS
+            std::swap(counters, rhs.counters);
+#endif
         }
 
         // 
@@ -104,33 +335,22 @@ namespace custom
         class local_iterator;
         iterator begin()
         {
-            for (int i = 0; i < 10; i++) { //this itBucket is an iterator through the array of 10 lists
-                if (!buckets[i].empty()) {
-                    auto testbegin = buckets + 1;
-                    auto testEnd = buckets + 10;
-                    auto testIt = buckets[i].begin();
-                    list<int> mylist;
-                    auto it2 = mylist.begin();
-                    iterator it = iterator(testbegin, testEnd, testIt);
-                    return it;
-                }
-            }
-
-
+            size_t i = nextOccupied(oldOccupied, iMigrate, numOldBuckets);
+            if (i < numOldBuckets)
+                return oldIteratorAt(i, oldBuckets[i].begin());
+            i = nextOccupied(occupied, 0, numBuckets);
+            if (i < numBuckets)
+                return iteratorAt(i, buckets[i].begin());
             return end();
         }
         iterator end()
         {
-            auto testbegin = buckets + 10;
-            auto testEnd = buckets + 10;
-            auto testIt = buckets[9].end();
-            return iterator(testbegin, testEnd, testIt);
+            return iteratorAt(numBuckets, typename Bucket::iterator());
         }
         local_iterator begin(size_t iBucket)
         {
             return local_iterator(buckets[iBucket].begin());
         }
-
         local_iterator end(size_t iBucket)
         {
             return local_iterator(buckets[iBucket].end());
@@ -139,32 +359,88 @@ namespace custom
         //
         // Access
         //
-        size_t bucket(const T& t)
+        size_t bucket(const Key& k) const
         {
-            std::hash<T> bucketHash;
-
-            return bucketHash(t) % bucket_count();
+            // a moved-from table has no buckets until its first insert
+            if (numBuckets == 0)
+                return 0;
+            return indexFor(hasher(k), numBuckets);
+        }
+        iterator find(const Key& k)
+        {
+            return findKey(k);
+        }
+        template <class K, class H = Hash, class = typename std::enable_if<is_transparent<H, KeyEqual>::value>::type>
+        iterator find(const K& k)
+        {
+            return findKey(k);
+        }
+        size_t count(const Key& k) const
+        {
+            return contains(k) ? 1 : 0;
+        }
+        template <class K, class H = Hash, class = typename std::enable_if<is_transparent<H, KeyEqual>::value>::type>
+        size_t count(const K& k) const
+        {
+            return contains(k) ? 1 : 0;
+        }
+        bool contains(const Key& k) const
+        {
+            return findKey(k) != notFound();
+        }
+        template <class K, class H = Hash, class = typename std::enable_if<is_transparent<H, KeyEqual>::value>::type>
+        bool contains(const K& k) const
+        {
+            return findKey(k) != notFound();
         }
-        iterator find(const T& t);
 
         //   
         // Insert
         //
-        custom::pair<iterator, bool> insert(const T& t);
-        void insert(const std::initializer_list<T>& il);
-
+        custom::pair<iterator, bool> insert(const Value& v);
+        void insert(const std::initializer_list<Value>& il)
+        {
+            insert(il.begin(), il.end());
+        }
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            insertRange(first, last, typename range_category<Iterator>::type());
+        }
+        void rehash(size_t numBuckets);
+        void reserve(size_t num)
+        {
+            rehash(static_cast<size_t>(std::ceil(num / maxLoadFactor)));
+        }
 
         // 
         // Remove
         //
         void clear() noexcept
         {
-            for (int i = 0; i < 10; i++) {
-                buckets[i].clear();
-            }
+            for (size_t i = nextOccupied(occupied, 0, numBuckets); i < numBuckets;
+                 i = nextOccupied(occupied, i + 1, numBuckets))
+                while (!buckets[i].empty())
+                    buckets[i].pop_front();
+            for (size_t i = nextOccupied(oldOccupied, iMigrate, numOldBuckets); i < numOldBuckets;
+                 i = nextOccupied(oldOccupied, i + 1, numOldBuckets))
+                while (!oldBuckets[i].empty())
+                    oldBuckets[i].pop_front();
+            std::fill_n(occupied, wordsFor(numBuckets), uint64_t(0));
+            endMigration();
+            filter.clear();
+            numErased = 0;
             numElements = 0;
         }
-        iterator erase(const T& t);
+        iterator erase(const Key& k)
+        {
+            return eraseKey(k);
+        }
+        template <class K, class H = Hash, class = typename std::enable_if<is_transparent<H, KeyEqual>::value>::type>
+        iterator erase(const K& k)
+        {
+            return eraseKey(k);
+        }
 
         //
         // Status
@@ -179,53 +455,340 @@ namespace custom
         }
         size_t bucket_count() const
         {
-            return 10;
+            return numBuckets;
         }
         size_t bucket_size(size_t i) const
         {
             return buckets[i].size();
         }
+        float load_factor() const
+        {
+            return numBuckets ? float(numElements) / float(numBuckets) : 0.0f;
+        }
+        float max_load_factor() const
+        {
+            return maxLoadFactor;
+        }
+        void max_load_factor(float ml)
+        {
+            assert(ml > 0.0f);
+            maxLoadFactor = ml;
+            if (load_factor() > maxLoadFactor)
+                rehash(0);
+        }
+        bool incremental_rehash() const
+        {
+            return incremental;
+        }
+        void incremental_rehash(bool on)
+        {
+            incremental = on;
+            if (!on)
+                migrate(numOldBuckets);
+        }
+        bool rehashing() const
+        {
+            return oldBuckets != nullptr;
+        }
+        bool bloom_filter() const
+        {
+            return filtered;
+        }
+        void bloom_filter(bool on)
+        {
+            filtered = on;
+            if (on)
+                rebuildFilter();
+            else
+                blocked_bloom_filter().swap(filter);
+        }
+        hash_stats stats() const;
+        void reset_stats()
+        {
+#ifdef CUSTOM_HASH_STATS
+            counters = Counters();
+#endif
+        }
 
-    private:
+    protected:
+
+        // how many old buckets each new key and each erase migrates
+        static const size_t MIGRATE_STEP = 4;
+
+        // how many elements insert(first, last) hashes and prefetches at once
+        static const size_t BATCH = 16;
+
+        // a range we can measure and batch, or one we can only read once
+        template <class Iterator>
+        void insertRange(Iterator first, Iterator last, std::forward_iterator_tag);
+        template <class Iterator>
+        void insertRange(Iterator first, Iterator last, std::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+
+        // the length of a range: subtraction for pointers, a walk otherwise
+        template <class Iterator>
+        static size_t distance(Iterator first, Iterator last)
+        {
+            size_t num = 0;
+            for (; first != last; ++first)
+                num++;
+            return num;
+        }
+        static size_t distance(const Value* first, const Value* last)
+        {
+            return last - first;
+        }
+        static size_t distance(Value* first, Value* last)
+        {
+            return last - first;
+        }
+
+        // a hint that p will be read soon
+        static void prefetch(const void* p)
+        {
+#if defined(__GNUC__)
+            __builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+            (void)p;
+#endif
+        }
+
+        static size_t indexFor(size_t h, size_t num)
+        {
+            return IndexPolicy::index(h, num);
+        }
+
+        // the occupancy bitmap: bit i is set while bucket i is not empty
+        static size_t wordsFor(size_t num)
+        {
+            return (num + 63) / 64;
+        }
+        static uint64_t* newBits(size_t num)
+        {
+            return new uint64_t[wordsFor(num)]();
+        }
+        static void setBit(uint64_t* bits, size_t i)
+        {
+            bits[i / 64] |= uint64_t(1) << (i % 64);
+        }
+        static void resetBit(uint64_t* bits, size_t i)
+        {
+            bits[i / 64] &= ~(uint64_t(1) << (i % 64));
+        }
+        static size_t lowestBit(uint64_t word);
+        static size_t nextOccupied(const uint64_t* bits, size_t i, size_t num);
+
+        // an iterator at bucket i of the array, or of the old one
+        // with the new array to follow
+        iterator iteratorAt(size_t i, typename Bucket::iterator itList) const
+        {
+            return iterator(buckets, buckets + numBuckets, occupied, buckets + i, itList);
+        }
+        iterator oldIteratorAt(size_t i, typename Bucket::iterator itList) const
+        {
+            return iterator(oldBuckets, oldBuckets + numOldBuckets, oldOccupied, oldBuckets + i, itList,
+                            buckets, buckets + numBuckets, occupied);
+        }
+
+        // end(), for the const lookups
+        iterator notFound() const
+        {
+            return iteratorAt(numBuckets, typename Bucket::iterator());
+        }
+
+        // the hash of an entry: kept, or computed again
+        size_t hashOf(const hash_entry<Value, true>& e) const
+        {
+            return e.hash;
+        }
+        size_t hashOf(const hash_entry<Value, false>& e) const
+        {
+            return hasher(keyOf(e.value));
+        }
+
+        // does an entry hold k? Check the kept hash first.
+        template <class K>
+        bool matches(const hash_entry<Value, true>& e, const K& k, size_t h) const
+        {
+            return e.hash == h && equal(keyOf(e.value), k);
+        }
+        template <class K>
+        bool matches(const hash_entry<Value, false>& e, const K& k, size_t) const
+        {
+            return equal(keyOf(e.value), k);
+        }
+        template <class K>
+        typename Bucket::iterator findInBucket(Bucket& b, const K& k, size_t h, size_t& probes) const
+        {
+            for (auto it = b.begin(); it != b.end(); ++it)
+            {
+                probes++;
+                if (matches(*it, k, h))
+                    return it;
+            }
+            return b.end();
+        }
+        template <class K>
+        iterator findKey(const K& k) const
+        {
+            return findHashed(k, hasher(k));
+        }
+        template <class K>
+        iterator findHashed(const K& k, size_t h) const;
+        iterator insertHashed(const Value& v, size_t h);
+        template <class K>
+        iterator eraseKey(const K& k)
+        {
+            return eraseHashed(k, hasher(k));
+        }
+        template <class K>
+        iterator eraseHashed(const K& k, size_t h);
+        void rebuildFilter();
+        void moveBucket(Bucket& from, Bucket* to, uint64_t* toBits, size_t numTo) const;
+        void migrate(size_t num);
+        void endMigration()
+        {
+            delete [] oldBuckets;
+            delete [] oldOccupied;
+            oldBuckets = nullptr;
+            oldOccupied = nullptr;
+            numOldBuckets = 0;
+            iMigrate = 0;
+        }
+
+#ifdef CUSTOM_HASH_STATS
+        typedef std::chrono::steady_clock Clock;
+        typedef Clock::time_point Stamp;
+
+        // what stats() cannot work out from the buckets. Lookups bump
+        // these from const methods, and concurrent_unordered_set runs
+        // those under a shared lock, so they are relaxed atomics.
+        struct Counters
+        {
+            Counters() : hits(0), misses(0), hitProbes(0), missProbes(0),
+                         rehashes(0), rehashTicks(0) {}
+            Counters(const Counters& rhs) { *this = rhs; }
+            Counters& operator = (const Counters& rhs)
+            {
+                hits = rhs.hits.load(std::memory_order_relaxed);
+                misses = rhs.misses.load(std::memory_order_relaxed);
+                hitProbes = rhs.hitProbes.load(std::memory_order_relaxed);
+                missProbes = rhs.missProbes.load(std::memory_order_relaxed);
+                rehashes = rhs.rehashes.load(std::memory_order_relaxed);
+                rehashTicks = rhs.rehashTicks.load(std::memory_order_relaxed);
+                return *this;
+            }
+            std::atomic<size_t> hits;
+            std::atomic<size_t> misses;
+            std::atomic<size_t> hitProbes;
+            std::atomic<size_t> missProbes;
+            std::atomic<size_t> rehashes;
+            std::atomic<Clock::rep> rehashTicks;   // Clock::duration counts
+        };
+
+        void countLookup(bool hit, size_t probes) const
+        {
+            if (hit)
+            {
+                counters.hits.fetch_add(1, std::memory_order_relaxed);
+                counters.hitProbes.fetch_add(probes, std::memory_order_relaxed);
+            }
+            else
+            {
+                counters.misses.fetch_add(1, std::memory_order_relaxed);
+                counters.missProbes.fetch_add(probes, std::memory_order_relaxed);
+            }
+        }
+        Stamp startTimer() const
+        {
+            return Clock::now();
+        }
+        void countRehash(const Stamp& start, bool replaced) const
+        {
+            counters.rehashTicks.fetch_add((Clock::now() - start).count(), std::memory_order_relaxed);
+            if (replaced)
+                counters.rehashes.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        mutable Counters counters;
+#else
+        struct Stamp {};
+        void countLookup(bool, size_t) const {}
+        Stamp startTimer() const { return Stamp(); }
+        void countRehash(const Stamp&, bool) const {}
+#endif
+
+        Bucket* buckets;   // the bucket array, on the heap
+        uint64_t* occupied;         // one bit per bucket, set if it is not empty
+        size_t numBuckets;          // the number of buckets in the array
+        size_t numElements;         // number of elements in the Hash
+        float maxLoadFactor;        // grow once size() / bucket_count() passes this
+
+        Bucket* oldBuckets; // during a migration, the array we are leaving
+        uint64_t* oldOccupied;       // and its bitmap
+        size_t numOldBuckets;        // the number of buckets in oldBuckets
+        size_t iMigrate;             // old buckets before this one are already moved
+        bool incremental;            // grow by migrating a little at a time
 
-        custom::list<T> buckets[10];   // exactly 10 buckets
-        int numElements;                // number of elements in the Hash
+        blocked_bloom_filter filter; // the hash of every element, when filtered
+        bool filtered;               // look in the filter before the buckets
+        size_t numErased;            // erased since the filter was last built
+        Hash hasher;
+        KeyEqual equal;
+        KeyOf keyOf;
     };
 
 
     /************************************************
-     * UNORDERED SET ITERATOR
+     * HASH TABLE ITERATOR
      * Iterator for an unordered set
      ************************************************/
-    template <typename T>
-    class unordered_set <T> ::iterator
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    class hash_table <Key, Value, KeyOf, Hash, KeyEqual> ::iterator
     {
         friend class ::TestHash;   // give unit tests access to the privates
-        template <class TT>
-        friend class custom::unordered_set;
+        friend class hash_table;
     public:
         // 
         // Construct
         //
         iterator()
         {
-            pBucket = nullptr;
+            pBucketBegin = nullptr;
             pBucketEnd = nullptr;
+            pBits = nullptr;
+            pBucket = nullptr;
             itList = nullptr;
+            pNextBucket = nullptr;
+            pNextEnd = nullptr;
+            pNextBits = nullptr;
         }
-        iterator(typename custom::list<T>* pBucket,
-            typename custom::list<T>* pBucketEnd,
-            typename custom::list<T>::iterator itList)
+        iterator(Bucket* pBucketBegin,
+            Bucket* pBucketEnd,
+            const uint64_t* pBits,
+            Bucket* pBucket,
+            typename Bucket::iterator itList,
+            Bucket* pNextBucket = nullptr,
+            Bucket* pNextEnd = nullptr,
+            const uint64_t* pNextBits = nullptr)
         {
-            this->pBucket = pBucket;
+            this->pBucketBegin = pBucketBegin;
             this->pBucketEnd = pBucketEnd;
+            this->pBits = pBits;
+            this->pBucket = pBucket;
             this->itList = itList;
+            this->pNextBucket = pNextBucket;
+            this->pNextEnd = pNextEnd;
+            this->pNextBits = pNextBits;
         }
         iterator(const iterator& rhs)
         {
-            this->pBucket = rhs.pBucket;
-            this->pBucketEnd = rhs.pBucketEnd;
-            this->itList = rhs.itList;
+            *this = rhs;
         }
 
         //
@@ -233,9 +796,14 @@ namespace custom
         //
         iterator& operator = (const iterator& rhs)
         {
-            this->pBucket = rhs.pBucket;
+            this->pBucketBegin = rhs.pBucketBegin;
             this->pBucketEnd = rhs.pBucketEnd;
+            this->pBits = rhs.pBits;
+            this->pBucket = rhs.pBucket;
             this->itList = rhs.itList;
+            this->pNextBucket = rhs.pNextBucket;
+            this->pNextEnd = rhs.pNextEnd;
+            this->pNextBits = rhs.pNextBits;
             return *this;
         }
 
@@ -254,9 +822,13 @@ namespace custom
         // 
         // Access
         //
-        T& operator * ()
+        Value& operator * ()
         {
-            return *itList;
+            return (*itList).value;
+        }
+        Value* operator -> ()
+        {
+            return &(*itList).value;
         }
 
         //
@@ -265,29 +837,33 @@ namespace custom
         iterator& operator ++ ();
         iterator operator ++ (int postfix)
         {
-            auto tempIt = this->itList;
-            this->itList++;
+            iterator tempIt(*this);
+            ++(*this);
             return tempIt;
         }
 
     private:
-        custom::list<T>* pBucket;
-        custom::list<T>* pBucketEnd;
-        typename list<T>::iterator itList;
+        Bucket* pBucketBegin;
+        Bucket* pBucketEnd;
+        const uint64_t* pBits; // which buckets in the array are not empty
+        Bucket* pBucket;
+        typename Bucket::iterator itList;
+        Bucket* pNextBucket;   // during a migration, the new array
+        Bucket* pNextEnd;      // follows the old one
+        const uint64_t* pNextBits;
     };
 
 
     /************************************************
-     * UNORDERED SET LOCAL ITERATOR
+     * HASH TABLE LOCAL ITERATOR
      * Iterator for a single bucket in an unordered set
      ************************************************/
-    template <typename T>
-    class unordered_set <T> ::local_iterator
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    class hash_table <Key, Value, KeyOf, Hash, KeyEqual> ::local_iterator
     {
         friend class ::TestHash;   // give unit tests access to the privates
 
-        template <class TT>
-        friend class custom::unordered_set;
+        friend class hash_table;
     public:
         // 
         // Construct
@@ -296,7 +872,7 @@ namespace custom
         {
             itList = nullptr;
         }
-        local_iterator(const typename custom::list<T>::iterator& itList)
+        local_iterator(const typename Bucket::iterator& itList)
         {
             this->itList = itList;
         }
@@ -329,9 +905,13 @@ namespace custom
         // 
         // Access
         //
-        T& operator * ()
+        Value& operator * ()
+        {
+            return (*itList).value;
+        }
+        Value* operator -> ()
         {
-            return *itList;
+            return &(*itList).value;
         }
 
         // 
@@ -349,18 +929,20 @@ namespace custom
         }
 
     private:
-        typename list<T>::iterator itList;
+        typename Bucket::iterator itList;
     };
 
 
     /*****************************************
-     * UNORDERED SET :: ERASE
+     * HASH TABLE :: ERASE
      * Remove one element from the unordered set
      ****************************************/
-    template <typename T>
-    typename unordered_set <T> ::iterator unordered_set<T>::erase(const T& t)
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    template <class K>
+    typename hash_table <Key, Value, KeyOf, Hash, KeyEqual> ::iterator hash_table <Key, Value, KeyOf, Hash, KeyEqual>::eraseHashed(const K& k, size_t h)
     {
-        auto itErase = find(t);
+        migrate(MIGRATE_STEP);
+        auto itErase = findHashed(k, h);
         if (itErase == end())
             return itErase;
 
@@ -368,68 +950,383 @@ namespace custom
         ++itReturn;
 
         itErase.pBucket->erase(itErase.itList);
+        if (itErase.pBucket->empty())
+            resetBit(itErase.pBucketBegin == buckets ? occupied : oldOccupied,
+                     itErase.pBucket - itErase.pBucketBegin);
         numElements--;
+
+        // the filter cannot forget; too many ghosts and we start over
+        if (filtered && ++numErased * 4 > numElements)
+            rebuildFilter();
         return itReturn;
     }
 
     /*****************************************
-     * UNORDERED SET :: INSERT
-     * Insert one element into the hash
+     * HASH TABLE :: INSERT
+     * Insert one element into the hash unless
+     * its key is already there
      ****************************************/
-    template <typename T>
-    custom::pair<typename custom::unordered_set<T>::iterator, bool> unordered_set<T>::insert(const T& t)
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    custom::pair<typename custom::hash_table <Key, Value, KeyOf, Hash, KeyEqual>::iterator, bool> hash_table <Key, Value, KeyOf, Hash, KeyEqual>::insert(const Value& v)
     {
-        // find the bucket where we need to add
-        int iBucket = bucket(t);
+        // check for duplicates, hashing the key only once
+        size_t h = hasher(keyOf(v));
+        auto itFind = findHashed(keyOf(v), h);
+        if (itFind != end())
+            return custom::pair<iterator, bool>(itFind, false);
+        return custom::pair<iterator, bool>(insertHashed(v, h), true);
+    }
 
-        // check for duplicates
-        auto it = buckets[iBucket].begin();
-        for (it; it != buckets[iBucket].end(); it++)
-            if ((*it) == t)
-                return custom::pair<custom::unordered_set<T>::iterator, bool>(iterator(buckets + iBucket, buckets + 10, it), false);
+    /*****************************************
+     * HASH TABLE :: INSERT HASHED
+     * Add v, whose key has hash h and is known not
+     * to be here yet, growing the bucket array
+     * first if it is too full
+     ****************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    typename hash_table <Key, Value, KeyOf, Hash, KeyEqual>::iterator hash_table <Key, Value, KeyOf, Hash, KeyEqual>::insertHashed(const Value& v, size_t h)
+    {
+        // pay off a little of any migration under way
+        migrate(MIGRATE_STEP);
+
+        // make room, either all at once or by starting a migration
+        if (numElements + 1 > maxLoadFactor * numBuckets)
+        {
+            if (incremental && numBuckets)
+            {
+                // migrate() times the moves; this times the new array
+                migrate(numOldBuckets);
+                auto start = startTimer();
+                oldBuckets = buckets;
+                oldOccupied = occupied;
+                numOldBuckets = numBuckets;
+                numBuckets *= 2;
+                buckets = new Bucket[numBuckets];
+                occupied = newBits(numBuckets);
+                if (filtered)
+                    rebuildFilter();
+                countRehash(start, true);
+                migrate(MIGRATE_STEP);
+            }
+            else
+                rehash(numBuckets * 2);
+        }
 
-        buckets[iBucket].push_back(t);
+        // find the bucket where we need to add
+        size_t iBucket = indexFor(h, numBuckets);
+        buckets[iBucket].push_back(Entry(v, h));
+        setBit(occupied, iBucket);
+        if (filtered)
+            filter.insert(h);
         numElements++;
-        it = buckets[iBucket].rbegin();
-        return custom::pair<custom::unordered_set<T>::iterator, bool>(iterator(buckets + iBucket, buckets + 10, it), true);
+        return iteratorAt(iBucket, buckets[iBucket].rbegin());
+    }
 
+    /*****************************************
+     * HASH TABLE :: INSERT RANGE
+     * Grow once for a big range, then insert it
+     * a batch at a time: hash the batch and prefetch
+     * its buckets, prefetch the chains those buckets
+     * start, then insert while all that is in flight
+     ****************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    template <class Iterator>
+    void hash_table <Key, Value, KeyOf, Hash, KeyEqual>::insertRange(Iterator first, Iterator last, std::forward_iterator_tag)
+    {
+        // at least double, so many small ranges do not rebuild the table
+        // every time. Small ranges and incremental tables just grow as
+        // they go; the point of incremental is never to rehash at once.
+        size_t num = distance(first, last);
+        if (!incremental && num >= BATCH && numElements + num > maxLoadFactor * numBuckets)
+            reserve(std::max(numElements + num, 2 * numElements));
 
+        // a moved-from table has no buckets to prefetch until its first insert
+        if (numBuckets == 0 && first != last)
+        {
+            insert(*first);
+            ++first;
+        }
+
+        size_t hashes[BATCH];
+        while (first != last)
+        {
+            // 1. hash the batch and ask for its buckets
+            size_t n = 0;
+            for (Iterator it = first; n < BATCH && it != last; ++it, ++n)
+            {
+                hashes[n] = hasher(keyOf(*it));
+                prefetch(buckets + indexFor(hashes[n], numBuckets));
+            }
+
+            // 2. the buckets have arrived by now; ask for their first entries
+            for (size_t i = 0; i < n; i++)
+            {
+                Bucket& b = buckets[indexFor(hashes[i], numBuckets)];
+                if (!b.empty())
+                    prefetch(&b.front());
+            }
+
+            // 3. insert, skipping keys already here
+            for (size_t i = 0; i < n; i++, ++first)
+                if (findHashed(keyOf(*first), hashes[i]) == end())
+                    insertHashed(*first, hashes[i]);
+        }
     }
-    template <typename T>
-    void unordered_set<T>::insert(const std::initializer_list<T>& il)
+
+    /*****************************************
+     * HASH TABLE :: REHASH
+     * Move every element into a new bucket array of
+     * at least numBuckets, and at least enough to
+     * stay under the max load factor
+     ****************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    void hash_table <Key, Value, KeyOf, Hash, KeyEqual>::rehash(size_t numBuckets)
     {
-        for (auto it = il.begin(); it != il.end(); it++)
+        migrate(numOldBuckets);
+
+        size_t numNeeded = static_cast<size_t>(std::ceil(numElements / maxLoadFactor));
+        if (numBuckets < numNeeded)
+            numBuckets = numNeeded;
+        if (numBuckets == 0)
+            numBuckets = 1;
+        numBuckets = IndexPolicy::bucket_count(numBuckets);
+        if (numBuckets == this->numBuckets)
+            return;
+
+        auto start = startTimer();
+        Bucket* newBuckets = new Bucket[numBuckets];
+        uint64_t* newOccupied = newBits(numBuckets);
+        for (size_t i = nextOccupied(occupied, 0, this->numBuckets); i < this->numBuckets;
+             i = nextOccupied(occupied, i + 1, this->numBuckets))
+            moveBucket(buckets[i], newBuckets, newOccupied, numBuckets);
+
+        delete [] buckets;
+        delete [] occupied;
+        buckets = newBuckets;
+        occupied = newOccupied;
+        this->numBuckets = numBuckets;
+
+        if (filtered)
+            rebuildFilter();
+        countRehash(start, true);
+    }
+
+    /*****************************************
+     * HASH TABLE :: MOVE BUCKET
+     * Empty one bucket into an array of numTo buckets,
+     * marking the buckets it lands in. With cached
+     * hashes this never calls the hasher.
+     ****************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    void hash_table <Key, Value, KeyOf, Hash, KeyEqual>::moveBucket(Bucket& from, Bucket* to, uint64_t* toBits, size_t numTo) const
+    {
+        while (!from.empty())
         {
-            insert((*it));
+            Entry& e = from.front();
+            size_t i = indexFor(hashOf(e), numTo);
+            to[i].push_back(std::move(e));
+            setBit(toBits, i);
+            from.pop_front();
         }
     }
 
     /*****************************************
-     * UNORDERED SET :: FIND
-     * Find an element in an unordered set
+     * HASH TABLE :: MIGRATE
+     * Move up to num non-empty old buckets into the
+     * new array. The bitmap skips the empty ones 64
+     * at a time. The last one out frees the old array.
      ****************************************/
-    template <typename T>
-    typename unordered_set <T> ::iterator unordered_set<T>::find(const T& t)
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    void hash_table <Key, Value, KeyOf, Hash, KeyEqual>::migrate(size_t num)
     {
-        // find the bucket the element would be in.
-        int iBucket = bucket(t);
-        auto itList = buckets[iBucket].find(t);
+        if (!oldBuckets)
+            return;
 
-        if (itList != buckets[iBucket].end())
+        auto start = startTimer();
+        while (oldBuckets && num)
+        {
+            iMigrate = nextOccupied(oldOccupied, iMigrate, numOldBuckets);
+            if (iMigrate < numOldBuckets)
+            {
+                moveBucket(oldBuckets[iMigrate], buckets, occupied, numBuckets);
+                resetBit(oldOccupied, iMigrate);
+                num--;
+                iMigrate++;
+            }
+            if (iMigrate == numOldBuckets)
+                endMigration();
+        }
+        countRehash(start, false);
+    }
+
+    /*****************************************
+     * HASH TABLE :: REBUILD FILTER
+     * Size the filter for as many elements as the
+     * buckets hold before the next growth, then add
+     * the hash of everything in both arrays
+     ****************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    void hash_table <Key, Value, KeyOf, Hash, KeyEqual>::rebuildFilter()
+    {
+        size_t numKeys = static_cast<size_t>(numBuckets * maxLoadFactor);
+        filter.resize(numKeys > numElements ? numKeys : numElements);
+
+        Bucket* arrays[2] = { buckets, oldBuckets };
+        const uint64_t* bits[2] = { occupied, oldOccupied };
+        size_t first[2] = { 0, iMigrate };
+        size_t num[2] = { numBuckets, numOldBuckets };
+        for (size_t a = 0; a < 2; a++)
+            for (size_t i = nextOccupied(bits[a], first[a], num[a]); i < num[a];
+                 i = nextOccupied(bits[a], i + 1, num[a]))
+                for (auto it = arrays[a][i].begin(); it != arrays[a][i].end(); ++it)
+                    filter.insert(hashOf(*it));
+        numErased = 0;
+    }
+
+    /*****************************************
+     * HASH TABLE :: NEXT OCCUPIED
+     * The first non-empty bucket at or after i,
+     * or num if there is none
+     ****************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    size_t hash_table <Key, Value, KeyOf, Hash, KeyEqual>::nextOccupied(const uint64_t* bits, size_t i, size_t num)
+    {
+        if (i >= num)
+            return num;
+
+        size_t iWord = i / 64;
+        size_t numWords = wordsFor(num);
+        uint64_t word = bits[iWord] & (~uint64_t(0) << (i % 64));
+        while (word == 0)
+        {
+            if (++iWord == numWords)
+                return num;
+            word = bits[iWord];
+        }
+        return iWord * 64 + lowestBit(word);
+    }
+
+    /*****************************************
+     * HASH TABLE :: LOWEST BIT
+     * Count the trailing zeros: one instruction
+     * where the compiler knows how
+     ****************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    size_t hash_table <Key, Value, KeyOf, Hash, KeyEqual>::lowestBit(uint64_t word)
+    {
+        assert(word != 0);
+#if defined(__GNUC__)
+        return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return index;
+#else
+        size_t i = 0;
+        while (!(word & 1))
+        {
+            word >>= 1;
+            i++;
+        }
+        return i;
+#endif
+    }
+
+    /*****************************************
+     * HASH TABLE :: FIND
+     * Find an element in an unordered set. During
+     * a migration it may still be in the old array.
+     * Only reads: a lookup never migrates.
+     ****************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    template <class K>
+    typename hash_table <Key, Value, KeyOf, Hash, KeyEqual> ::iterator hash_table <Key, Value, KeyOf, Hash, KeyEqual>::findHashed(const K& k, size_t h) const
+    {
+        if (numBuckets == 0)
+            return notFound();
+
+        // one cache line settles most misses
+        if (filtered && !filter.might_contain(h))
         {
-            auto testbegin = buckets + iBucket;
-            auto testEnd = buckets + 10;
-            return iterator(testbegin, testEnd, itList);
+            countLookup(false, 0);
+            return notFound();
         }
-        return end();
+
+        size_t probes = 0;   // keys compared, for the stats
+
+        if (oldBuckets)
+        {
+            size_t iOld = indexFor(h, numOldBuckets);
+            if (iOld >= iMigrate)
+            {
+                auto itList = findInBucket(oldBuckets[iOld], k, h, probes);
+                if (itList != oldBuckets[iOld].end())
+                {
+                    countLookup(true, probes);
+                    return oldIteratorAt(iOld, itList);
+                }
+            }
+        }
+
+        // find the bucket the element would be in.
+        size_t iBucket = indexFor(h, numBuckets);
+        auto itList = findInBucket(buckets[iBucket], k, h, probes);
+
+        countLookup(itList != buckets[iBucket].end(), probes);
+        if (itList != buckets[iBucket].end())
+            return iteratorAt(iBucket, itList);
+        return notFound();
     }
 
     /*****************************************
-     * UNORDERED SET :: ITERATOR :: INCREMENT
+     * HASH TABLE :: STATS
+     * Walk the non-empty buckets of both arrays to
+     * measure the chains, then add the counters
+     ****************************************/
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    hash_stats hash_table <Key, Value, KeyOf, Hash, KeyEqual>::stats() const
+    {
+        hash_stats s = hash_stats();
+        s.size = numElements;
+        s.bucketCount = numBuckets + numOldBuckets - iMigrate;
+        s.loadFactor = s.bucketCount ? float(numElements) / float(s.bucketCount) : 0.0f;
+
+        size_t numNonEmpty = 0;
+        const Bucket* arrays[2] = { buckets, oldBuckets };
+        const uint64_t* bits[2] = { occupied, oldOccupied };
+        size_t first[2] = { 0, iMigrate };
+        size_t num[2] = { numBuckets, numOldBuckets };
+        for (size_t a = 0; a < 2; a++)
+            for (size_t i = nextOccupied(bits[a], first[a], num[a]); i < num[a];
+                 i = nextOccupied(bits[a], i + 1, num[a]))
+            {
+                size_t length = arrays[a][i].size();
+                if (length > s.maxChain)
+                    s.maxChain = length;
+                s.chainLengths[length < hash_stats::HISTOGRAM ? length : hash_stats::HISTOGRAM - 1]++;
+                numNonEmpty++;
+            }
+        s.chainLengths[0] = s.bucketCount - numNonEmpty;
+        s.meanChain = numNonEmpty ? float(numElements) / float(numNonEmpty) : 0.0f;
+
+#ifdef CUSTOM_HASH_STATS
+        Counters c(counters);
+        s.hits = c.hits;
+        s.misses = c.misses;
+        s.hitProbes = c.hits ? float(c.hitProbes) / float(c.hits) : 0.0f;
+        s.missProbes = c.misses ? float(c.missProbes) / float(c.misses) : 0.0f;
+        s.rehashes = c.rehashes;
+        s.rehashSeconds = std::chrono::duration<double>(Clock::duration(c.rehashTicks)).count();
+#endif
+        return s;
+    }
+
+    /*****************************************
+     * HASH TABLE :: ITERATOR :: INCREMENT
      * Advance by one element in an unordered set
      ****************************************/
-    template <typename T>
-    typename unordered_set <T> ::iterator& unordered_set<T>::iterator::operator ++ ()
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    typename hash_table <Key, Value, KeyOf, Hash, KeyEqual> ::iterator& hash_table <Key, Value, KeyOf, Hash, KeyEqual>::iterator::operator ++ ()
     {
         /*
          itList = itList
@@ -444,23 +1341,74 @@ namespace custom
         ++itList;
         if (itList != pBucket->end())
             return *this;
-        // 3. If we are at the end, move to the next bucket.
-        ++pBucket;
-        while (pBucket != pBucketEnd && pBucket->empty())
-            ++pBucket;
+        // 3. If we are at the end, jump to the next non-empty bucket.
+        size_t num = pBucketEnd - pBucketBegin;
+        pBucket = pBucketBegin + nextOccupied(pBits, (pBucket - pBucketBegin) + 1, num);
+
+        // 4. Past the old array during a migration? Go on to the new one.
+        if (pBucket == pBucketEnd && pNextBucket != pNextEnd)
+        {
+            pBucketBegin = pNextBucket;
+            pBucketEnd = pNextEnd;
+            pBits = pNextBits;
+            pNextBucket = pNextEnd = nullptr;
+            pNextBits = nullptr;
+            pBucket = pBucketBegin + nextOccupied(pBits, 0, pBucketEnd - pBucketBegin);
+        }
 
         if (pBucket != pBucketEnd)
             itList = pBucket->begin();
         return *this;
     }
 
+    /************************************************
+     * UNORDERED SET
+     * A set implemented as a hash
+     ************************************************/
+    template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+    class unordered_set : public hash_table<T, T, key_of_value, Hash, KeyEqual>
+    {
+        friend class ::TestHash;   // give unit tests access to the privates
+        typedef hash_table<T, T, key_of_value, Hash, KeyEqual> Base;
+    public:
+        //
+        // Construct
+        //
+        unordered_set(size_t numBuckets = 8, const Hash& hasher = Hash(), const KeyEqual& equal = KeyEqual()) :
+            Base(numBuckets, hasher, equal) {}
+        unordered_set(unordered_set& rhs) : Base(rhs) {}
+        unordered_set(unordered_set&& rhs) : Base(std::move(rhs)) {}
+        template <class Iterator>
+        unordered_set(Iterator first, Iterator last) : Base(first, last) {}
+        unordered_set(const std::initializer_list<T>& il) : Base(il) {}
+
+        //
+        // Assign
+        //
+        unordered_set& operator=(unordered_set& rhs)
+        {
+            Base::operator=(rhs);
+            return *this;
+        }
+        unordered_set& operator=(unordered_set&& rhs)
+        {
+            Base::operator=(std::move(rhs));
+            return *this;
+        }
+        unordered_set& operator=(const std::initializer_list<T>& il)
+        {
+            Base::operator=(il);
+            return *this;
+        }
+    };
+
     /*****************************************
      * SWAP
-     * Stand-alone unordered set swap
+     * Stand-alone hash swap
      ****************************************/
-    template <typename T>
-    void swap(unordered_set<T>& lhs, unordered_set<T>& rhs)
+    template <typename Key, typename Value, typename KeyOf, typename Hash, typename KeyEqual>
+    void swap(hash_table <Key, Value, KeyOf, Hash, KeyEqual>& lhs, hash_table <Key, Value, KeyOf, Hash, KeyEqual>& rhs)
     {
-        std::swap(lhs, rhs);
+        lhs.swap(rhs);
     }
 }
\ No newline at end of file
@@ -0,0 +1,290 @@
+/***********************************************************************
+ * Header:
+ *    HASHING
+ * Summary:
+ *    Hash functions that mix well and bucket policies that use it
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the definitions of:
+ *        hashing::mix            : Fold the 128 bit product of two words
+ *        hashing::hash_bytes     : Hash a span of bytes, wyhash style
+ *        hashing::hash           : A drop-in for std::hash
+ *        hashing::string_hash    : Transparent hash for every kind of string
+ *        modulo_index            : Bucket = hash % buckets
+ *        mask_index              : Bucket = hash & (buckets - 1)
+ *        fastrange_index         : Bucket = high word of hash * buckets
+ *
+ *    std::hash of an integer is the integer itself, so a table has to
+ *    use % to make every bit count, and % costs 20 to 40 cycles. The
+ *    hashes here multiply the input into a full 128 bit product and fold
+ *    it, so every output bit depends on every input bit. With a hash like
+ *    that the table can pick buckets from the high bits with one multiply
+ *    (fastrange) or from the low bits with a mask.
+ *
+ *    A Hash picks its bucket policy by declaring a nested index_policy
+ *    type; hash_table uses modulo_index for any Hash that does not.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>      // for uint64_t and SIZE_MAX
+#include <cstring>      // for std::memcpy and std::strlen
+#include <string>       // for std::string
+#include <type_traits>  // for std::enable_if
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <string_view>  // for std::string_view
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>     // for _umul128 and __umulh
+#endif
+
+namespace custom
+{
+
+    /*****************************************
+     * MODULO INDEX
+     * Any bucket count, any hash, but a divide
+     ****************************************/
+    struct modulo_index
+    {
+        static size_t index(size_t h, size_t num) { return h % num; }
+        static size_t bucket_count(size_t num) { return num; }
+    };
+
+    /*****************************************
+     * MASK INDEX
+     * The low bits of the hash. The bucket count
+     * is always a power of two, so the low bits
+     * had better be well mixed.
+     ****************************************/
+    struct mask_index
+    {
+        static size_t index(size_t h, size_t num) { return h & (num - 1); }
+        static size_t bucket_count(size_t num)
+        {
+            size_t p = 1;
+            while (p < num)
+                p *= 2;
+            return p;
+        }
+    };
+
+    /*****************************************
+     * FASTRANGE INDEX
+     * Scale the hash into [0, num) with a multiply:
+     * the high word of h * num. Any bucket count,
+     * but the high bits had better be well mixed.
+     ****************************************/
+    struct fastrange_index
+    {
+        static size_t index(size_t h, size_t num)
+        {
+#if defined(__SIZEOF_INT128__)
+            return static_cast<size_t>((static_cast<unsigned __int128>(h) * num) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            return static_cast<size_t>(__umulh(h, num));
+#elif SIZE_MAX == 0xFFFFFFFFu
+            return index32(static_cast<uint32_t>(h), static_cast<uint32_t>(num));
+#else
+            return index64(static_cast<uint64_t>(h), static_cast<uint64_t>(num));
+#endif
+        }
+        static size_t bucket_count(size_t num) { return num; }
+
+        // a 32 bit hash: the whole product fits in 64 bits
+        static uint32_t index32(uint32_t h, uint32_t num)
+        {
+            return static_cast<uint32_t>((static_cast<uint64_t>(h) * num) >> 32);
+        }
+
+        // a 64 bit hash with no 128 bit product: the high half of the
+        // hash times the bucket count, which is exact to within one
+        // bucket for any count under 2^32
+        static uint64_t index64(uint64_t h, uint64_t num)
+        {
+            return ((h >> 32) * (num & 0xFFFFFFFFu)) >> 32;
+        }
+    };
+
+    namespace hashing
+    {
+        // the wyhash primes
+        const uint64_t P0 = 0xa0761d6478bd642full;
+        const uint64_t P1 = 0xe7037ed1a0b428dbull;
+        const uint64_t P2 = 0x8ebc6af09c88c6e3ull;
+        const uint64_t P3 = 0x589965cc75374cc3ull;
+
+        /*****************************************
+         * MIX
+         * Multiply two words into 128 bits and fold
+         * the halves together with xor
+         ****************************************/
+        inline uint64_t mix(uint64_t a, uint64_t b)
+        {
+#if defined(__SIZEOF_INT128__)
+            unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+            return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            uint64_t hi;
+            uint64_t lo = _umul128(a, b, &hi);
+            return lo ^ hi;
+#else
+            uint64_t aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+            uint64_t bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+            uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+            uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+            uint64_t lo = (mid << 32) | (ll & 0xFFFFFFFFu);
+            uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+            return lo ^ hi;
+#endif
+        }
+
+        /*****************************************
+         * HASH INTEGER
+         * One multiply for a 64 bit key
+         ****************************************/
+        inline uint64_t hash_integer(uint64_t x, uint64_t seed = 0)
+        {
+            return mix(x ^ P0 ^ seed, P1);
+        }
+
+        // read without caring about alignment; memcpy becomes one load
+        inline uint64_t read64(const unsigned char* p)
+        {
+            uint64_t v;
+            std::memcpy(&v, p, 8);
+            return v;
+        }
+        inline uint64_t read32(const unsigned char* p)
+        {
+            uint32_t v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+
+        /*****************************************
+         * HASH BYTES
+         * 16 bytes per mix, then up to 16 more read as
+         * two overlapping words so there is no byte loop
+         ****************************************/
+        inline uint64_t hash_bytes(const void* data, size_t len, uint64_t seed = 0)
+        {
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            seed ^= P0;
+            uint64_t a;
+            uint64_t b;
+
+            if (len <= 16)
+            {
+                if (len >= 4)
+                {
+                    a = (read32(p) << 32) | read32(p + ((len >> 3) << 2));
+                    b = (read32(p + len - 4) << 32) | read32(p + len - 4 - ((len >> 3) << 2));
+                }
+                else if (len > 0)
+                {
+                    a = (uint64_t(p[0]) << 16) | (uint64_t(p[len >> 1]) << 8) | p[len - 1];
+                    b = 0;
+                }
+                else
+                    a = b = 0;
+            }
+            else
+            {
+                size_t i = len;
+                for (; i > 16; i -= 16, p += 16)
+                    seed = mix(read64(p) ^ P1, read64(p + 8) ^ seed);
+                a = read64(p + i - 16);
+                b = read64(p + i - 8);
+            }
+
+            return mix(P1 ^ len, mix(a ^ P1, b ^ seed));
+        }
+
+        /*****************************************
+         * HASH
+         * For numbers, enums and pointers. Use it
+         * wherever std::hash would go.
+         ****************************************/
+        template <class T, class = void>
+        struct hash;
+
+        template <class T>
+        struct hash <T, typename std::enable_if<std::is_integral<T>::value ||
+                                                std::is_enum<T>::value>::type>
+        {
+            typedef fastrange_index index_policy;
+            size_t operator () (T t) const
+            {
+                return static_cast<size_t>(hash_integer(static_cast<uint64_t>(t)));
+            }
+        };
+
+        template <class T>
+        struct hash <T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+        {
+            typedef fastrange_index index_policy;
+            size_t operator () (T t) const
+            {
+                if (t == T(0))
+                    t = T(0);   // -0.0 == 0.0, so they must hash alike
+                return static_cast<size_t>(hash_bytes(&t, sizeof(t)));
+            }
+        };
+
+        template <class T>
+        struct hash <T*>
+        {
+            typedef fastrange_index index_policy;
+            size_t operator () (T* p) const
+            {
+                return static_cast<size_t>(hash_integer(reinterpret_cast<uintptr_t>(p)));
+            }
+        };
+
+        /*****************************************
+         * STRING HASH
+         * Every string type hashes its characters
+         * the same way, so a set of std::string can
+         * be searched with a const char*
+         ****************************************/
+        struct string_hash
+        {
+            typedef void is_transparent;
+            typedef fastrange_index index_policy;
+
+            size_t operator () (const std::string& s) const
+            {
+                return static_cast<size_t>(hash_bytes(s.data(), s.size()));
+            }
+            size_t operator () (const char* s) const
+            {
+                return static_cast<size_t>(hash_bytes(s, std::strlen(s)));
+            }
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+            size_t operator () (std::string_view s) const
+            {
+                return static_cast<size_t>(hash_bytes(s.data(), s.size()));
+            }
+#endif
+        };
+
+        template <>
+        struct hash <std::string> : string_hash {};
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+        template <>
+        struct hash <std::string_view> : string_hash {};
+#endif
+
+    } // namespace hashing
+
+} // namespace custom
@@ -831,5 +831,24 @@ namespace custom
         this->numElements = tempElements;
     }
 
+    /**********************************************
+     * COPY SOURCE
+     * list only copies from a non-const list, though
+     * it never changes it. The stack and queue
+     * adaptors copy their container through this so
+     * they can sit on a list too.
+     *********************************************/
+    template <class C>
+    const C& copy_source(const C& c)
+    {
+        return c;
+    }
+
+    template <typename T>
+    list <T>& copy_source(const list <T>& c)
+    {
+        return const_cast<list <T>&>(c);
+    }
+
     //#endif
 }; // namespace custom
\ No newline at end of file
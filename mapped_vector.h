@@ -0,0 +1,509 @@
+/***********************************************************************
+ * Header:
+ *    MAPPED VECTOR
+ * Summary:
+ *    A vector that lives in a memory-mapped file
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        mapped_vector           : A vector backed by a file
+ *        mapped_vector::iterator : An interator through mapped_vector
+ *
+ *    The file starts with a 64 byte header (magic number, type fingerprint,
+ *    size and capacity) followed by the elements. Opening a file only maps
+ *    it, so it is nearly instant no matter how big it is; pages are read
+ *    from disk the first time they are touched. sync() is the durability
+ *    point: everything before it is on disk when it returns.
+ *
+ *    Only trivially copyable types can be stored, since the bytes in the
+ *    file are the objects. The fingerprint is the size and alignment of T
+ *    plus a tag the caller picks, so a file opens the same under every
+ *    compiler; give two types of the same size and alignment different
+ *    tags to keep one from being opened as the other.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <cstdint>      // for uint64_t
+#include <utility>      // for std::move
+#include <type_traits>  // for std::is_trivially_copyable
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>    // for CreateFileMapping and MapViewOfFile
+#else
+#include <fcntl.h>      // for open
+#include <unistd.h>     // for ftruncate and close
+#include <sys/mman.h>   // for mmap, munmap and msync
+#include <sys/stat.h>   // for fstat
+#endif
+
+class TestMappedVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************
+     * MAPPED VECTOR
+     * Same interface as custom::vector <T>, but
+     * the buffer is a mapping of a file
+     ****************************************/
+    template <typename T>
+    class mapped_vector
+    {
+        friend class ::TestMappedVector; // give unit tests access to the privates
+        static_assert(std::is_trivially_copyable<T>::value,
+            "mapped_vector can only hold trivially copyable types");
+    public:
+
+        //
+        // Construct
+        //
+
+        mapped_vector(const char* fileName, uint64_t tag = 0);
+        mapped_vector(mapped_vector&& rhs);
+        mapped_vector(const mapped_vector& rhs) = delete;
+        ~mapped_vector();
+
+        //
+        // Assign
+        //
+
+        mapped_vector& operator = (const mapped_vector& rhs) = delete;
+        mapped_vector& operator = (mapped_vector&& rhs);
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator begin() { return data(); }
+        iterator end() { return data() + size(); }
+
+        //
+        // Access
+        //
+
+        T& operator [] (size_t index) { return data()[index]; }
+        const T& operator [] (size_t index) const { return data()[index]; }
+        T& front() { return data()[0]; }
+        const T& front() const { return data()[0]; }
+        T& back() { return data()[size() - 1]; }
+        const T& back() const { return data()[size() - 1]; }
+
+        //
+        // Insert
+        //
+
+        void push_back(const T& t);
+        void reserve(size_t newCapacity);
+        void resize(size_t newElements);
+        void resize(size_t newElements, const T& t);
+
+        //
+        // Remove
+        //
+
+        void clear() { header()->numElements = 0; }
+        void pop_back()
+        {
+            if (header()->numElements != 0)
+                header()->numElements -= 1;
+        }
+        void shrink_to_fit() { remap(size()); }
+
+        //
+        // Durability
+        //
+
+        void sync();
+
+        //
+        // Status
+        //
+
+        size_t  size()          const { return static_cast<size_t>(header()->numElements); }
+        size_t  capacity()      const { return static_cast<size_t>(header()->numCapacity); }
+        bool empty()            const { return size() == 0; }
+
+    private:
+
+        // the first 64 bytes of the file
+        struct Header
+        {
+            uint64_t magic;          // always MAGIC
+            uint64_t fingerprint;    // which T wrote this file
+            uint64_t numElements;    // the number of items currently used
+            uint64_t numCapacity;    // the number of items the file has room for
+            uint64_t reserved[4];    // pad to a cache line
+        };
+
+        static const uint64_t MAGIC = 0x524f544345564d43ull;   // "CMVECTOR"
+
+        static uint64_t fingerprint(uint64_t tag);
+        static size_t bytesFor(size_t numCapacity) { return sizeof(Header) + numCapacity * sizeof(T); }
+
+        Header* header() const { return reinterpret_cast<Header*>(pMap); }
+        T* data() const { return reinterpret_cast<T*>(pMap + sizeof(Header)); }
+
+        void map(size_t numBytes);
+        void unmap();
+        void remap(size_t newCapacity);
+
+        unsigned char* pMap;     // the whole file, header first
+        size_t numBytes;         // how much of the file is mapped
+#ifdef _WIN32
+        HANDLE hFile;
+        HANDLE hMapping;
+#else
+        int fd;
+#endif
+    };
+
+    /**************************************************
+     * MAPPED VECTOR ITERATOR
+     * A thin wrapper over a pointer into the mapping
+     *************************************************/
+    template <typename T>
+    class mapped_vector <T> ::iterator
+    {
+        friend class ::TestMappedVector; // give unit tests access to the privates
+    public:
+        // constructors, destructors, and assignment operator
+        iterator() { this->p = nullptr; }
+        iterator(T* p) { this->p = p; }
+        iterator(const iterator& rhs) { this->p = rhs.p; }
+        iterator& operator = (const iterator& rhs)
+        {
+            this->p = rhs.p;
+            return *this;
+        }
+
+        // equals, not equals operator
+        bool operator != (const iterator& rhs) const { return rhs.p != p; }
+        bool operator == (const iterator& rhs) const { return rhs.p == p; }
+
+        // dereference operator
+        T& operator * () { return *p; }
+
+        // prefix increment
+        iterator& operator ++ ()
+        {
+            p++;
+            return *this;
+        }
+
+        // postfix increment
+        iterator operator ++ (int)
+        {
+            iterator returnCopy(*this);
+            p++;
+            return returnCopy;
+        }
+
+        // prefix decrement
+        iterator& operator -- ()
+        {
+            p--;
+            return *this;
+        }
+
+        // postfix decrement
+        iterator operator -- (int)
+        {
+            iterator returnCopy(*this);
+            p--;
+            return returnCopy;
+        }
+
+    private:
+        T* p;
+    };
+
+    /*****************************************
+     * MAPPED VECTOR :: FINGERPRINT
+     * Hash the caller's tag with the size and alignment
+     * of T so a file written with one type is not
+     * opened as another
+     ****************************************/
+    template <typename T>
+    uint64_t mapped_vector <T> ::fingerprint(uint64_t tag)
+    {
+        uint64_t hash = 14695981039346656037ull;        // FNV-1a
+        for (int i = 0; i < 64; i += 8)
+            hash = (hash ^ ((tag >> i) & 0xFF)) * 1099511628211ull;
+        hash = (hash ^ sizeof(T)) * 1099511628211ull;
+        hash = (hash ^ alignof(T)) * 1099511628211ull;
+        return hash;
+    }
+
+    /*****************************************
+     * MAPPED VECTOR :: OPEN constructor
+     * Open (or create) fileName and map it. A new
+     * file gets a fresh header; an existing one must
+     * have been written with the same T and tag.
+     * Once the file is open, anything that throws
+     * closes it again on the way out.
+     ****************************************/
+    template <typename T>
+    mapped_vector <T> ::mapped_vector(const char* fileName, uint64_t tag) : pMap(nullptr), numBytes(0)
+    {
+#ifdef _WIN32
+        hMapping = NULL;
+        hFile = CreateFileA(fileName, GENERIC_READ | GENERIC_WRITE, 0, NULL,
+            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (hFile == INVALID_HANDLE_VALUE)
+            throw "ERROR: unable to open the mapped_vector file";
+#else
+        fd = ::open(fileName, O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+            throw "ERROR: unable to open the mapped_vector file";
+#endif
+
+        try
+        {
+            size_t fileSize = 0;
+#ifdef _WIN32
+            LARGE_INTEGER li;
+            if (!GetFileSizeEx(hFile, &li))
+                throw "ERROR: unable to read the size of the mapped_vector file";
+            fileSize = static_cast<size_t>(li.QuadPart);
+#else
+            struct stat st;
+            if (fstat(fd, &st) != 0)
+                throw "ERROR: unable to read the size of the mapped_vector file";
+            fileSize = static_cast<size_t>(st.st_size);
+#endif
+
+            if (fileSize == 0)
+            {
+                map(bytesFor(0));
+                header()->magic = MAGIC;
+                header()->fingerprint = fingerprint(tag);
+                header()->numElements = 0;
+                header()->numCapacity = 0;
+            }
+            else if (fileSize < sizeof(Header))
+                throw "ERROR: the mapped_vector file is too small";
+            else
+            {
+                map(fileSize);
+                if (header()->magic != MAGIC || header()->fingerprint != fingerprint(tag) ||
+                    bytesFor(capacity()) > fileSize)
+                    throw "ERROR: the mapped_vector file holds a different type";
+            }
+        }
+        catch (...)
+        {
+            unmap();
+            throw;
+        }
+    }
+
+    /*****************************************
+     * MAPPED VECTOR :: MOVE constructor
+     * Steal the mapping from the RHS
+     ****************************************/
+    template <typename T>
+    mapped_vector <T> ::mapped_vector(mapped_vector&& rhs) : pMap(nullptr), numBytes(0)
+    {
+#ifdef _WIN32
+        hFile = INVALID_HANDLE_VALUE;
+        hMapping = NULL;
+#else
+        fd = -1;
+#endif
+        *this = std::move(rhs);
+    }
+
+    /*****************************************
+     * MAPPED VECTOR :: DESTRUCTOR
+     * Unmapping does not force a write; call sync()
+     * first if the data must be on disk
+     ****************************************/
+    template <typename T>
+    mapped_vector <T> :: ~mapped_vector()
+    {
+        unmap();
+    }
+
+    /*****************************************
+     * MAPPED VECTOR :: MOVE ASSIGNMENT
+     ****************************************/
+    template <typename T>
+    mapped_vector <T>& mapped_vector <T> :: operator = (mapped_vector&& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        unmap();
+        pMap = rhs.pMap;
+        numBytes = rhs.numBytes;
+        rhs.pMap = nullptr;
+        rhs.numBytes = 0;
+#ifdef _WIN32
+        hFile = rhs.hFile;
+        hMapping = rhs.hMapping;
+        rhs.hFile = INVALID_HANDLE_VALUE;
+        rhs.hMapping = NULL;
+#else
+        fd = rhs.fd;
+        rhs.fd = -1;
+#endif
+        return *this;
+    }
+
+    /*****************************************
+     * MAPPED VECTOR :: MAP
+     * Grow the file to newBytes and map all of it
+     ****************************************/
+    template <typename T>
+    void mapped_vector <T> ::map(size_t newBytes)
+    {
+#ifdef _WIN32
+        LARGE_INTEGER li;
+        li.QuadPart = static_cast<LONGLONG>(newBytes);
+        SetFilePointerEx(hFile, li, NULL, FILE_BEGIN);
+        SetEndOfFile(hFile);
+        hMapping = CreateFileMappingA(hFile, NULL, PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(newBytes) >> 32),
+            static_cast<DWORD>(newBytes), NULL);
+        void* p = hMapping ? MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, newBytes) : NULL;
+        if (!p)
+            throw "ERROR: unable to map the mapped_vector file";
+#else
+        if (ftruncate(fd, static_cast<off_t>(newBytes)) != 0)
+            throw "ERROR: unable to grow the mapped_vector file";
+        void* p = mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED)
+            throw "ERROR: unable to map the mapped_vector file";
+#endif
+        pMap = static_cast<unsigned char*>(p);
+        numBytes = newBytes;
+    }
+
+    /*****************************************
+     * MAPPED VECTOR :: UNMAP
+     * Drop the mapping and close the file
+     ****************************************/
+    template <typename T>
+    void mapped_vector <T> ::unmap()
+    {
+#ifdef _WIN32
+        if (pMap)
+            UnmapViewOfFile(pMap);
+        if (hMapping)
+            CloseHandle(hMapping);
+        if (hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(hFile);
+        hMapping = NULL;
+        hFile = INVALID_HANDLE_VALUE;
+#else
+        if (pMap)
+            munmap(pMap, numBytes);
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+#endif
+        pMap = nullptr;
+        numBytes = 0;
+    }
+
+    /*****************************************
+     * MAPPED VECTOR :: REMAP
+     * Resize the file to hold newCapacity elements
+     * and map it again. The file keeps its handle.
+     ****************************************/
+    template <typename T>
+    void mapped_vector <T> ::remap(size_t newCapacity)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(pMap);
+        CloseHandle(hMapping);
+        hMapping = NULL;
+#else
+        munmap(pMap, numBytes);
+#endif
+        pMap = nullptr;
+        map(bytesFor(newCapacity));
+        header()->numCapacity = newCapacity;
+    }
+
+    /***************************************
+     * MAPPED VECTOR :: RESERVE
+     * Grow the file so it has room for newCapacity
+     * elements. The old elements stay where they are
+     * in the file; only the mapping moves.
+     **************************************/
+    template <typename T>
+    void mapped_vector <T> ::reserve(size_t newCapacity)
+    {
+        if (newCapacity > capacity())
+            remap(newCapacity);
+    }
+
+    /***************************************
+     * MAPPED VECTOR :: RESIZE
+     **************************************/
+    template <typename T>
+    void mapped_vector <T> ::resize(size_t newElements)
+    {
+        resize(newElements, T());
+    }
+
+    template <typename T>
+    void mapped_vector <T> ::resize(size_t newElements, const T& t)
+    {
+        reserve(newElements);
+        for (size_t i = size(); i < newElements; i++)
+            data()[i] = t;
+        header()->numElements = newElements;
+    }
+
+    /***************************************
+     * MAPPED VECTOR :: PUSH BACK
+     * Add t to the end, doubling the file as needed
+     **************************************/
+    template <typename T>
+    void mapped_vector <T> ::push_back(const T& t)
+    {
+        if (size() == capacity())
+        {
+            T copy = t;   // t may live in the mapping we are about to move
+            reserve(capacity() ? capacity() * 2 : 1);
+            data()[header()->numElements++] = copy;
+        }
+        else
+            data()[header()->numElements++] = t;
+    }
+
+    /***************************************
+     * MAPPED VECTOR :: SYNC
+     * Write every dirty page (header included) to
+     * disk and wait for it to finish
+     **************************************/
+    template <typename T>
+    void mapped_vector <T> ::sync()
+    {
+#ifdef _WIN32
+        if (!FlushViewOfFile(pMap, 0) || !FlushFileBuffers(hFile))
+            throw "ERROR: unable to sync the mapped_vector file";
+#else
+        if (msync(pMap, numBytes, MS_SYNC) != 0)
+            throw "ERROR: unable to sync the mapped_vector file";
+#endif
+    }
+
+} // namespace custom
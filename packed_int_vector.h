@@ -0,0 +1,363 @@
+/***********************************************************************
+ * Header:
+ *    PACKED INT VECTOR
+ * Summary:
+ *    A compressed vector of unsigned 64 bit integers
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        packed_int_vector           : A frame-of-reference packed vector
+ *        packed_int_vector::iterator : A block-at-a-time decoding iterator
+ *
+ *    Values are grouped into blocks of 128. Each full block stores its
+ *    smallest value (the frame of reference) and then every value minus
+ *    that, packed in just enough bits for the largest difference. A block
+ *    of b bits takes exactly 2b words. For sorted IDs with a typical gap
+ *    g the widest difference in a block is about 127g, so each value
+ *    takes about log2(g) + 7 bits: some 7 bits more than delta encoding,
+ *    paid for random access. The block table is the skip index:
+ *    operator [] finds the block, then the bits, in O(1), where deltas
+ *    would have to decode up to 127 values.
+ *    The last, partly filled block is kept unpacked until it fills up.
+ *
+ *    The bits are laid out vertically, in LANES = 2 interleaved streams
+ *    of 64 bit words, one SSE2 register wide: value i goes to lane
+ *    i % LANES, and word j of each lane sits next to word j of the other. Every lane of a slot then needs the same
+ *    shift and mask, and for each bit width there is a straight-line
+ *    unpacker with those shifts fixed at compile time, so decoding a block
+ *    is branch-free and the compiler can do the lanes side by side in one
+ *    SIMD register.
+ *
+ *    Values cannot be changed once added; push_back is the only write.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <cstdint>      // for uint64_t
+#include <utility>      // for std::index_sequence
+#include "vector.h"     // the blocks and the bits live in vectors
+
+class TestPackedIntVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************
+     * PACKED INT VECTOR
+     * An append-only vector <uint64_t> that
+     * packs every full block of 128 values
+     ****************************************/
+    class packed_int_vector
+    {
+        friend class ::TestPackedIntVector; // give unit tests access to the privates
+    public:
+        static const size_t BLOCK = 128;   // values per block
+
+        class iterator;
+
+        //
+        // Construct
+        //
+
+        packed_int_vector() : numTail(0) {}
+        packed_int_vector(const std::initializer_list<uint64_t>& l) : numTail(0)
+        {
+            for (uint64_t value : l)
+                push_back(value);
+        }
+
+        //
+        // Iterator
+        //
+
+        iterator begin() const;
+        iterator end() const;
+
+        //
+        // Access
+        //
+
+        uint64_t operator [] (size_t index) const;
+        uint64_t front() const { return (*this)[0]; }
+        uint64_t back() const { return (*this)[size() - 1]; }
+
+        //
+        // Insert
+        //
+
+        void push_back(uint64_t value)
+        {
+            tail[numTail++] = value;
+            if (numTail == BLOCK)
+                seal();
+        }
+
+        //
+        // Remove
+        //
+
+        void clear()
+        {
+            blocks.clear();
+            words.clear();
+            numTail = 0;
+        }
+
+        //
+        // Status
+        //
+
+        size_t size()  const { return blocks.size() * BLOCK + numTail; }
+        bool empty()   const { return size() == 0; }
+        size_t bytes() const
+        {
+            return blocks.size() * sizeof(Block) + words.size() * sizeof(uint64_t) + sizeof(tail);
+        }
+
+    private:
+
+        // one entry in the skip index
+        struct Block
+        {
+            uint64_t base;     // the smallest value in the block
+            uint64_t offset;   // the first word of the block in words
+            unsigned bits;     // bits per value, 0 to 64
+        };
+
+        static const size_t LANES = 2;     // interleaved bit streams per block
+
+        static uint64_t mask(unsigned bits) { return bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1; }
+        static unsigned bitsFor(uint64_t range);
+        uint64_t extract(const Block& block, size_t i) const;
+        void decode(size_t iBlock, uint64_t* out) const;
+        void seal();
+
+        // unpack one full block of Bits bit values, one slot of every lane at a time.
+        // out never overlaps the words, and saying so lets the lanes share a register.
+        typedef void (*Unpacker)(const uint64_t* in, uint64_t base, uint64_t* out);
+        template <unsigned Bits, size_t Slot>
+        static void unpackSlot(const uint64_t* __restrict in, uint64_t base, uint64_t* __restrict out);
+        template <unsigned Bits, size_t ... Slots>
+        static void unpack(const uint64_t* in, uint64_t base, uint64_t* out, std::index_sequence<Slots...>)
+        {
+            int expand[] = { 0, (unpackSlot<Bits, Slots>(in, base, out), 0)... };
+            (void)expand;
+        }
+        template <unsigned Bits>
+        static void unpack(const uint64_t* in, uint64_t base, uint64_t* out)
+        {
+            unpack<Bits>(in, base, out, std::make_index_sequence<BLOCK / LANES>());
+        }
+        template <unsigned ... Bits>
+        static const Unpacker* unpackers(std::integer_sequence<unsigned, Bits...>)
+        {
+            static const Unpacker table[] = { &unpack<Bits>... };
+            return table;
+        }
+
+        vector<Block> blocks;      // the skip index, one per full block
+        vector<uint64_t> words;    // the packed bits of every full block
+        uint64_t tail[BLOCK];      // the last block, not yet packed
+        size_t numTail;            // the number of values in tail
+    };
+
+    /**************************************************
+     * PACKED INT VECTOR ITERATOR
+     * Decodes a whole block when it steps into it,
+     * then hands the values out one at a time
+     *************************************************/
+    class packed_int_vector::iterator
+    {
+        friend class ::TestPackedIntVector; // give unit tests access to the privates
+    public:
+        // constructors, destructors, and assignment operator
+        iterator() : index(0), iBlock(0), v(nullptr) {}
+        iterator(size_t index, const packed_int_vector* v) : index(index), iBlock(size_t(-1)), v(v) {}
+
+        // equals, not equals operator
+        bool operator != (const iterator& rhs) const { return rhs.index != index; }
+        bool operator == (const iterator& rhs) const { return rhs.index == index; }
+
+        // dereference operator
+        uint64_t operator * ()
+        {
+            if (index / BLOCK != iBlock)
+            {
+                iBlock = index / BLOCK;
+                v->decode(iBlock, buffer);
+            }
+            return buffer[index % BLOCK];
+        }
+
+        // prefix increment
+        iterator& operator ++ ()
+        {
+            index++;
+            return *this;
+        }
+
+        // postfix increment
+        iterator operator ++ (int)
+        {
+            iterator returnCopy(*this);
+            index++;
+            return returnCopy;
+        }
+
+    private:
+        size_t index;                  // which value we are on
+        size_t iBlock;                 // which block is in buffer
+        const packed_int_vector* v;
+        uint64_t buffer[BLOCK];        // the decoded block
+    };
+
+    inline packed_int_vector::iterator packed_int_vector::begin() const { return iterator(0, this); }
+    inline packed_int_vector::iterator packed_int_vector::end() const { return iterator(size(), this); }
+
+    /*****************************************
+     * PACKED INT VECTOR :: BITS FOR
+     * How many bits it takes to hold range
+     ****************************************/
+    inline unsigned packed_int_vector::bitsFor(uint64_t range)
+    {
+        unsigned bits = 0;
+        while (bits < 64 && (range >> bits) != 0)
+            bits++;
+        return bits;
+    }
+
+    /*****************************************
+     * PACKED INT VECTOR :: EXTRACT
+     * Value i of a packed block: slot i / LANES of
+     * lane i % LANES. A value can straddle two words
+     * of its lane.
+     ****************************************/
+    inline uint64_t packed_int_vector::extract(const Block& block, size_t i) const
+    {
+        if (block.bits == 0)
+            return block.base;
+
+        size_t bitPos = i / LANES * block.bits;
+        size_t iWord = static_cast<size_t>(block.offset) + bitPos / 64 * LANES + i % LANES;
+        unsigned shift = bitPos % 64;
+
+        uint64_t value = words[iWord] >> shift;
+        if (shift + block.bits > 64)
+            value |= words[iWord + LANES] << (64 - shift);
+        return block.base + (value & mask(block.bits));
+    }
+
+    /*****************************************
+     * PACKED INT VECTOR :: UNPACK SLOT
+     * Value Slot of every lane. Bits and Slot are
+     * constants, so the word, the shift and whether
+     * the value straddles two words are all known
+     * at compile time.
+     ****************************************/
+    template <unsigned Bits, size_t Slot>
+    inline void packed_int_vector::unpackSlot(const uint64_t* __restrict in, uint64_t base, uint64_t* __restrict out)
+    {
+        const size_t iWord = Slot * Bits / 64 * LANES;
+        const unsigned shift = Slot * Bits % 64;
+        for (size_t lane = 0; lane < LANES; lane++)
+        {
+            uint64_t value = in[iWord + lane] >> shift;
+            if (shift + Bits > 64)
+                value |= in[iWord + LANES + lane] << ((64 - shift) % 64);
+            out[Slot * LANES + lane] = base + (value & mask(Bits));
+        }
+    }
+
+    /*****************************************
+     * PACKED INT VECTOR :: SUBSCRIPT
+     * Find the block in the skip index, then the value
+     ****************************************/
+    inline uint64_t packed_int_vector::operator [] (size_t index) const
+    {
+        size_t iBlock = index / BLOCK;
+        if (iBlock == blocks.size())
+            return tail[index % BLOCK];
+        return extract(blocks[iBlock], index % BLOCK);
+    }
+
+    /*****************************************
+     * PACKED INT VECTOR :: DECODE
+     * Unpack every value of one block into out
+     ****************************************/
+    inline void packed_int_vector::decode(size_t iBlock, uint64_t* out) const
+    {
+        if (iBlock == blocks.size())
+        {
+            for (size_t i = 0; i < numTail; i++)
+                out[i] = tail[i];
+            return;
+        }
+
+        const Block& block = blocks[iBlock];
+        if (block.bits == 0)
+        {
+            for (size_t i = 0; i < BLOCK; i++)
+                out[i] = block.base;
+            return;
+        }
+
+        static const Unpacker* table = unpackers(std::make_integer_sequence<unsigned, 65>());
+        table[block.bits](&words[static_cast<size_t>(block.offset)], block.base, out);
+    }
+
+    /*****************************************
+     * PACKED INT VECTOR :: SEAL
+     * Pack the full tail into 2 * bits words,
+     * LANES interleaved streams of them, and add
+     * it to the skip index
+     ****************************************/
+    inline void packed_int_vector::seal()
+    {
+        uint64_t base = tail[0];
+        uint64_t top = tail[0];
+        for (size_t i = 1; i < BLOCK; i++)
+        {
+            if (tail[i] < base)
+                base = tail[i];
+            if (tail[i] > top)
+                top = tail[i];
+        }
+
+        Block block;
+        block.base = base;
+        block.offset = words.size();
+        block.bits = bitsFor(top - base);
+
+        size_t newWords = words.size() + BLOCK * block.bits / 64;
+        if (newWords > words.capacity())
+            words.reserve(newWords > words.capacity() * 2 ? newWords : words.capacity() * 2);
+        words.resize(newWords, 0);
+        for (size_t i = 0; i < BLOCK; i++)
+        {
+            uint64_t value = tail[i] - base;
+            size_t bitPos = i / LANES * block.bits;
+            size_t iWord = static_cast<size_t>(block.offset) + bitPos / 64 * LANES + i % LANES;
+            unsigned shift = bitPos % 64;
+
+            if (block.bits == 0)
+                continue;
+            words[iWord] |= value << shift;
+            if (shift + block.bits > 64)
+                words[iWord + LANES] |= value >> (64 - shift);
+        }
+
+        blocks.push_back(block);
+        numTail = 0;
+    }
+
+} // namespace custom
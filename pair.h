@@ -0,0 +1,90 @@
+/***********************************************************************
+ * Header:
+ *    PAIR
+ * Summary:
+ *    A key and a value held together
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        pair                 : similar to std::pair
+ *        make_pair            : build a pair, deducing the types
+ *
+ *    Unlike std::pair, two pairs compare by their first member alone.
+ *    map keeps pairs in a BST and finds one by building a pair from the
+ *    key and a default value, so the value must not take part.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <utility>      // for std::move and std::forward
+
+namespace custom
+{
+
+    /*****************************************
+     * PAIR
+     * first and second, compared by first
+     ****************************************/
+    template <typename T1, typename T2>
+    struct pair
+    {
+        //
+        // Construct
+        //
+
+        pair() : first(), second() {}
+        pair(const T1& first, const T2& second) : first(first), second(second) {}
+        template <class U1, class U2>
+        pair(U1&& first, U2&& second) : first(std::forward<U1>(first)), second(std::forward<U2>(second)) {}
+        template <class U1, class U2>
+        pair(const pair<U1, U2>& rhs) : first(rhs.first), second(rhs.second) {}
+        pair(const pair& rhs) = default;
+        pair(pair&& rhs) = default;
+
+        //
+        // Assign
+        //
+
+        pair& operator = (const pair& rhs) = default;
+        pair& operator = (pair&& rhs) = default;
+        void swap(pair& rhs)
+        {
+            using std::swap;
+            swap(first, rhs.first);
+            swap(second, rhs.second);
+        }
+
+        //
+        // Compare
+        //
+
+        bool operator == (const pair& rhs) const { return first == rhs.first; }
+        bool operator != (const pair& rhs) const { return !(first == rhs.first); }
+        bool operator <  (const pair& rhs) const { return first < rhs.first; }
+        bool operator >  (const pair& rhs) const { return rhs.first < first; }
+        bool operator <= (const pair& rhs) const { return !(rhs.first < first); }
+        bool operator >= (const pair& rhs) const { return !(first < rhs.first); }
+
+        T1 first;
+        T2 second;
+    };
+
+    /*****************************************
+     * MAKE PAIR
+     ****************************************/
+    template <typename T1, typename T2>
+    pair<T1, T2> make_pair(const T1& first, const T2& second)
+    {
+        return pair<T1, T2>(first, second);
+    }
+
+} // namespace custom
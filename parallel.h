@@ -0,0 +1,584 @@
+/***********************************************************************
+ * Header:
+ *    PARALLEL
+ * Summary:
+ *    Multi-threaded algorithms over custom::vector
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the definition of:
+ *        parallel::thread_pool    : A work-stealing pool of threads
+ *        parallel::task_group     : Fork some tasks, then join them
+ *        parallel::for_each_range : Split [0, n) into grain-sized pieces
+ *        parallel::sort           : Merge sort
+ *        parallel::transform      : Apply a function to every element
+ *        parallel::reduce         : Combine every element
+ *        parallel::inclusive_scan : Running totals
+ *        parallel::fill           : Set every element
+ *        parallel::filled         : vector(num, t), filled in parallel
+ *
+ *    Each thread in the pool has its own queue. A thread works from the
+ *    back of its own queue and, when that runs dry, steals from the front
+ *    of someone else's. A thread waiting on a task_group runs tasks while
+ *    it waits, so nested parallelism cannot deadlock.
+ *
+ *    The grain is the most elements one task handles by itself. Smaller
+ *    grains balance better; larger grains cost less in overhead. If a
+ *    task throws, the first exception is kept and rethrown by wait().
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>             // because I am paranoid
+#include <atomic>              // for std::atomic
+#include <thread>              // for std::thread
+#include <mutex>               // for std::mutex
+#include <condition_variable>  // for std::condition_variable
+#include <functional>          // for std::function and std::less
+#include <deque>               // each worker's queue of tasks
+#include <vector>              // for std::vector of queues and threads
+#include <memory>              // for std::unique_ptr
+#include <algorithm>           // for std::sort and std::merge
+#include <utility>             // for std::move
+#include <exception>           // for std::exception_ptr
+#include "vector.h"            // for vector
+
+namespace custom
+{
+namespace parallel
+{
+    // a good default for the most elements one task handles by itself
+    const size_t defaultGrain = 16384;
+
+    /*****************************************
+     * THREAD POOL
+     * One queue per thread, stealing when idle
+     ****************************************/
+    class thread_pool
+    {
+    public:
+        explicit thread_pool(size_t numThreads = std::thread::hardware_concurrency());
+        ~thread_pool();
+
+        // the pool every algorithm here uses
+        static thread_pool& instance()
+        {
+            static thread_pool pool;
+            return pool;
+        }
+
+        void submit(std::function<void()> task);
+        bool runOne();
+        size_t size() const { return queues.size(); }
+
+    private:
+        struct Queue
+        {
+            std::mutex lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        bool pop(size_t iQueue, std::function<void()>& task);
+        bool steal(size_t iThief, std::function<void()>& task);
+        void work(size_t iQueue);
+        size_t myQueue() const;
+
+        std::vector<std::unique_ptr<Queue>> queues;   // one per thread
+        std::vector<std::thread> threads;
+        std::atomic<size_t> numPending;               // tasks waiting in any queue
+        mutable std::atomic<size_t> nextQueue;        // where outside threads submit
+        std::atomic<bool> done;
+        std::mutex sleepLock;                         // idle threads wait here
+        std::condition_variable wake;
+    };
+
+    // which pool and queue the calling thread works for, if any
+    struct worker_id
+    {
+        const thread_pool* pool;
+        size_t iQueue;
+    };
+    inline worker_id& currentWorker()
+    {
+        static thread_local worker_id id = { nullptr, 0 };
+        return id;
+    }
+
+    /*****************************************
+     * THREAD POOL :: CONSTRUCTOR
+     ****************************************/
+    inline thread_pool::thread_pool(size_t numThreads) : numPending(0), nextQueue(0), done(false)
+    {
+        if (numThreads == 0)
+            numThreads = 1;
+        for (size_t i = 0; i < numThreads; i++)
+            queues.emplace_back(new Queue);
+        for (size_t i = 0; i < numThreads; i++)
+            threads.emplace_back([this, i] { work(i); });
+    }
+
+    /*****************************************
+     * THREAD POOL :: DESTRUCTOR
+     * Let every thread finish what it has
+     ****************************************/
+    inline thread_pool::~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            done = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : threads)
+            t.join();
+    }
+
+    /*****************************************
+     * THREAD POOL :: MY QUEUE
+     * A worker pushes to its own queue; anyone
+     * else spreads tasks round robin
+     ****************************************/
+    inline size_t thread_pool::myQueue() const
+    {
+        const worker_id& id = currentWorker();
+        if (id.pool == this)
+            return id.iQueue;
+        return nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+
+    /*****************************************
+     * THREAD POOL :: SUBMIT
+     ****************************************/
+    inline void thread_pool::submit(std::function<void()> task)
+    {
+        Queue& q = *queues[myQueue()];
+        {
+            std::lock_guard<std::mutex> guard(q.lock);
+            q.tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            numPending++;
+        }
+        wake.notify_one();
+    }
+
+    /*****************************************
+     * THREAD POOL :: POP and STEAL
+     * Our own work comes off the back (the newest,
+     * still warm in the cache); stolen work comes
+     * off the front (the oldest, usually the biggest)
+     ****************************************/
+    inline bool thread_pool::pop(size_t iQueue, std::function<void()>& task)
+    {
+        Queue& q = *queues[iQueue];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.tasks.empty())
+            return false;
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    inline bool thread_pool::steal(size_t iThief, std::function<void()>& task)
+    {
+        for (size_t i = 1; i <= queues.size(); i++)
+        {
+            Queue& q = *queues[(iThief + i) % queues.size()];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (!q.tasks.empty())
+            {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*****************************************
+     * THREAD POOL :: RUN ONE
+     * Run a single task if there is one anywhere.
+     * Waiting threads call this to help out.
+     ****************************************/
+    inline bool thread_pool::runOne()
+    {
+        const worker_id& id = currentWorker();
+        size_t iQueue = id.pool == this ? id.iQueue : 0;
+
+        std::function<void()> task;
+        if (!(id.pool == this && pop(iQueue, task)) && !steal(iQueue, task))
+            return false;
+
+        numPending--;
+        task();
+        return true;
+    }
+
+    /*****************************************
+     * THREAD POOL :: WORK
+     * The loop each thread runs until the pool goes away
+     ****************************************/
+    inline void thread_pool::work(size_t iQueue)
+    {
+        currentWorker() = { this, iQueue };
+        while (true)
+        {
+            if (runOne())
+                continue;
+
+            std::unique_lock<std::mutex> guard(sleepLock);
+            wake.wait(guard, [this] { return done || numPending > 0; });
+            if (done && numPending == 0)
+                return;
+        }
+    }
+
+    /*****************************************
+     * TASK GROUP
+     * Start tasks with run(); wait() returns once
+     * they have all finished
+     ****************************************/
+    class task_group
+    {
+    public:
+        task_group(thread_pool& pool = thread_pool::instance()) : pool(pool), numRunning(0) {}
+        ~task_group() { join(); }
+
+        template <class F>
+        void run(F f)
+        {
+            numRunning++;
+            pool.submit([this, f]
+            {
+                // count the task done however it ends
+                struct Done
+                {
+                    std::atomic<size_t>& numRunning;
+                    ~Done() { numRunning--; }
+                } done = { numRunning };
+
+                try
+                {
+                    f();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> guard(errorLock);
+                    if (!error)
+                        error = std::current_exception();
+                }
+            });
+        }
+
+        // wait for every task, then rethrow the first exception one threw
+        void wait()
+        {
+            join();
+            std::exception_ptr e;
+            {
+                std::lock_guard<std::mutex> guard(errorLock);
+                std::swap(e, error);
+            }
+            if (e)
+                std::rethrow_exception(e);
+        }
+
+    private:
+        void join()
+        {
+            while (numRunning > 0)
+                if (!pool.runOne())
+                    std::this_thread::yield();
+        }
+
+        thread_pool& pool;
+        std::atomic<size_t> numRunning;
+        std::mutex errorLock;
+        std::exception_ptr error;   // the first exception a task threw
+    };
+
+    /*****************************************
+     * FOR EACH RANGE
+     * Call f(begin, end) on grain-sized pieces of
+     * [begin, end), splitting in half recursively
+     ****************************************/
+    template <class F>
+    void for_each_range(size_t begin, size_t end, size_t grain, const F& f)
+    {
+        if (grain == 0)
+            grain = 1;
+        if (end - begin <= grain)
+        {
+            if (begin != end)
+                f(begin, end);
+            return;
+        }
+
+        size_t middle = begin + (end - begin) / 2;
+        task_group group;
+        group.run([=, &f] { for_each_range(middle, end, grain, f); });
+        for_each_range(begin, middle, grain, f);
+        group.wait();
+    }
+
+    /*****************************************
+     * MERGE
+     * Merge two sorted runs into out in parallel.
+     * Split the longer run in half and find where
+     * its middle lands in the shorter one.
+     ****************************************/
+    template <typename T, class Compare>
+    void merge(T* a, size_t numA, T* b, size_t numB, T* out, size_t grain, const Compare& comp)
+    {
+        if (numA < numB)
+        {
+            std::swap(a, b);
+            std::swap(numA, numB);
+        }
+        if (numA + numB <= grain || numB == 0)
+        {
+            std::merge(std::make_move_iterator(a), std::make_move_iterator(a + numA),
+                       std::make_move_iterator(b), std::make_move_iterator(b + numB), out, comp);
+            return;
+        }
+
+        size_t midA = numA / 2;
+        size_t midB = std::lower_bound(b, b + numB, a[midA], comp) - b;
+
+        task_group group;
+        group.run([=, &comp] { merge(a + midA, numA - midA, b + midB, numB - midB, out + midA + midB, grain, comp); });
+        merge(a, midA, b, midB, out, grain, comp);
+        group.wait();
+    }
+
+    /*****************************************
+     * SORT RANGE
+     * Sort p[0, n) using buffer, also n long.
+     * The result ends up in p.
+     ****************************************/
+    template <typename T, class Compare>
+    void sortRange(T* p, T* buffer, size_t n, size_t grain, const Compare& comp)
+    {
+        if (n <= grain)
+        {
+            std::sort(p, p + n, comp);
+            return;
+        }
+
+        size_t middle = n / 2;
+        {
+            task_group group;
+            group.run([=, &comp] { sortRange(p + middle, buffer + middle, n - middle, grain, comp); });
+            sortRange(p, buffer, middle, grain, comp);
+            group.wait();
+        }
+
+        merge(p, middle, p + middle, n - middle, buffer, grain, comp);
+        for_each_range(0, n, grain, [=](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                p[i] = std::move(buffer[i]);
+        });
+    }
+
+    /*****************************************
+     * PARALLEL :: SORT
+     * Sort a vector with a parallel merge sort
+     ****************************************/
+    template <typename T, size_t Align, bool Huge, class Compare>
+    void sort(vector <T, Align, Huge>& v, const Compare& comp, size_t grain = defaultGrain)
+    {
+        if (v.size() < 2)
+            return;
+        vector<T> buffer(v.size());
+        sortRange(&v[0], &buffer[0], v.size(), grain, comp);
+    }
+
+    template <typename T, size_t Align, bool Huge>
+    void sort(vector <T, Align, Huge>& v)
+    {
+        sort(v, std::less<T>());
+    }
+
+    /*****************************************
+     * PARALLEL :: TRANSFORM
+     * Replace every element t with f(t)
+     ****************************************/
+    template <typename T, size_t Align, bool Huge, class F>
+    void transform(vector <T, Align, Huge>& v, const F& f, size_t grain = defaultGrain)
+    {
+        if (v.empty())
+            return;
+        T* p = &v[0];
+        for_each_range(0, v.size(), grain, [=, &f](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                p[i] = f(p[i]);
+        });
+    }
+
+    /*****************************************
+     * PARALLEL :: FILL
+     * Set every element to t
+     ****************************************/
+    template <typename T, size_t Align, bool Huge>
+    void fill(vector <T, Align, Huge>& v, const T& t, size_t grain = defaultGrain)
+    {
+        if (v.empty())
+            return;
+        T* p = &v[0];
+        for_each_range(0, v.size(), grain, [=, &t](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                p[i] = t;
+        });
+    }
+
+    /*****************************************
+     * VECTOR ACCESS
+     * Size a vector without initializing its
+     * elements, so filled() leaves the first write
+     * to each page to the workers
+     ****************************************/
+    struct vector_access
+    {
+        template <typename T, size_t Align, bool Huge>
+        static void uninitialized(vector <T, Align, Huge>& v, size_t num)
+        {
+            assert(v.data == nullptr);
+            v.data = vector <T, Align, Huge> ::allocate(num);
+            v.numCapacity = num;
+            v.numElements = num;
+        }
+    };
+
+    /*****************************************
+     * PARALLEL :: FILLED
+     * The parallel version of vector(num, t). For a
+     * trivial T nothing touches the buffer before the
+     * workers do, so each page is first written, and
+     * on a NUMA machine placed, by the thread that
+     * fills it.
+     ****************************************/
+    template <typename T>
+    vector<T> filled(size_t num, const T& t, size_t grain = defaultGrain)
+    {
+        vector<T> v;
+        vector_access::uninitialized(v, num);
+        fill(v, t, grain);
+        return v;
+    }
+
+    /*****************************************
+     * PARALLEL :: REDUCE
+     * Combine init and every element with op.
+     * op must be associative; the order of the
+     * elements within each piece is kept.
+     ****************************************/
+    template <typename T, size_t Align, bool Huge, class Op>
+    T reduce(const vector <T, Align, Huge>& v, T init, const Op& op, size_t grain = defaultGrain)
+    {
+        if (v.empty())
+            return init;
+        if (grain == 0)
+            grain = 1;
+
+        const T* p = &v.front();
+        size_t numPieces = (v.size() + grain - 1) / grain;
+        vector<T> partial(numPieces);
+        T* pPartial = &partial[0];
+
+        for_each_range(0, numPieces, 1, [=, &op, &v](size_t begin, size_t end)
+        {
+            for (size_t k = begin; k < end; k++)
+            {
+                size_t first = k * grain;
+                size_t last = first + grain < v.size() ? first + grain : v.size();
+                T acc = p[first];
+                for (size_t i = first + 1; i < last; i++)
+                    acc = op(acc, p[i]);
+                pPartial[k] = acc;
+            }
+        });
+
+        for (size_t k = 0; k < numPieces; k++)
+            init = op(init, pPartial[k]);
+        return init;
+    }
+
+    template <typename T, size_t Align, bool Huge>
+    T reduce(const vector <T, Align, Huge>& v, T init = T())
+    {
+        return reduce(v, init, [](const T& a, const T& b) { return a + b; });
+    }
+
+    /*****************************************
+     * PARALLEL :: INCLUSIVE SCAN
+     * Replace v[i] with v[0] op ... op v[i].
+     * Pass one totals each piece, a short serial
+     * pass turns the totals into carries, and pass
+     * two scans each piece starting from its carry.
+     ****************************************/
+    template <typename T, size_t Align, bool Huge, class Op>
+    void inclusive_scan(vector <T, Align, Huge>& v, const Op& op, size_t grain = defaultGrain)
+    {
+        if (v.empty())
+            return;
+        if (grain == 0)
+            grain = 1;
+
+        T* p = &v[0];
+        size_t n = v.size();
+        size_t numPieces = (n + grain - 1) / grain;
+        vector<T> carry(numPieces);
+        T* pCarry = &carry[0];
+
+        // pass one: the total of each piece
+        for_each_range(0, numPieces, 1, [=, &op](size_t begin, size_t end)
+        {
+            for (size_t k = begin; k < end; k++)
+            {
+                size_t first = k * grain;
+                size_t last = first + grain < n ? first + grain : n;
+                T acc = p[first];
+                for (size_t i = first + 1; i < last; i++)
+                    acc = op(acc, p[i]);
+                pCarry[k] = acc;
+            }
+        });
+
+        // the carry into piece k is the total of everything before it
+        for (size_t k = 1; k < numPieces; k++)
+            pCarry[k] = op(pCarry[k - 1], pCarry[k]);
+
+        // pass two: scan each piece from its carry
+        for_each_range(0, numPieces, 1, [=, &op](size_t begin, size_t end)
+        {
+            for (size_t k = begin; k < end; k++)
+            {
+                size_t first = k * grain;
+                size_t last = first + grain < n ? first + grain : n;
+                if (k != 0)
+                    p[first] = op(pCarry[k - 1], p[first]);
+                for (size_t i = first + 1; i < last; i++)
+                    p[i] = op(p[i - 1], p[i]);
+            }
+        });
+    }
+
+    template <typename T, size_t Align, bool Huge>
+    void inclusive_scan(vector <T, Align, Huge>& v)
+    {
+        inclusive_scan(v, [](const T& a, const T& b) { return a + b; });
+    }
+
+} // namespace parallel
+} // namespace custom
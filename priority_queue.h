@@ -52,17 +52,8 @@ namespace custom
         {
         }
         template <class Iterator>
-        priority_queue(Iterator first, Iterator last) : container{ vector<T>() }
+        priority_queue(Iterator first, Iterator last) : container(first, last)
         {
-
-            for (auto it = first; it != last; it++) {
-                container.push_back(*(it));
-
-            }
-            container.shrink_to_fit();
-
-
-
         }
         explicit priority_queue(custom::vector<T>&& rhs) : container(vector<T>(std::move(rhs)))
         {
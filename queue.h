@@ -0,0 +1,198 @@
+/***********************************************************************
+ * Header:
+ *    QUEUE
+ * Summary:
+ *    Our custom implementation of std::queue
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *       queue             : similar to std::queue
+ *
+ *    Besides one-at-a-time push and pop, push_range, pop_n and drain_into
+ *    work on a whole batch. On a vector a batch costs one reservation or
+ *    one shift rather than one per element.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <utility>      // for std::move and std::forward
+#include "list.h"       // the default container
+#include "vector.h"     // batches on a vector are cheaper
+
+class TestQueue;        // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * QUEUE
+     * First-in-First-out data structure, adapting any
+     * container with push_back, pop_front, front and back
+     **************************************************/
+    template <typename T, typename Container = list<T>>
+    class queue
+    {
+        friend class ::TestQueue; // give unit tests access to the privates
+    public:
+
+        //
+        // Construct
+        //
+
+        queue() {}
+        queue(const queue& rhs) : container(copy_source(rhs.container)) {}
+        queue(queue&& rhs) : container(std::move(rhs.container)) {}
+        explicit queue(const Container& rhs) : container(rhs) {}
+        explicit queue(Container&& rhs) : container(std::move(rhs)) {}
+        ~queue() {}
+
+        //
+        // Assign
+        //
+
+        queue& operator = (const queue& rhs)
+        {
+            container = copy_source(rhs.container);
+            return *this;
+        }
+        queue& operator = (queue&& rhs)
+        {
+            container = std::move(rhs.container);
+            return *this;
+        }
+        void swap(queue& rhs) { container.swap(rhs.container); }
+
+        //
+        // Access
+        //
+
+        T& front()
+        {
+            if (empty())
+                throw "std:out_of_range";
+            return container.front();
+        }
+        T& back()
+        {
+            if (empty())
+                throw "std:out_of_range";
+            return container.back();
+        }
+
+        //
+        // Insert
+        //
+
+        void push(const T& t) { container.push_back(t); }
+        void push(T&& t) { container.push_back(std::move(t)); }
+        template <class ... Args>
+        void emplace(Args&& ... args) { emplaceBack(container, std::forward<Args>(args)...); }
+        template <class Iterator>
+        void push_range(Iterator first, Iterator last) { appendRange(container, first, last); }
+
+        //
+        // Remove
+        //
+
+        void pop()
+        {
+            if (!empty())
+                popFront(container, 1);
+        }
+        void pop_n(size_t num) { popFront(container, num < size() ? num : size()); }
+        template <class Out>
+        size_t drain_into(Out& out, size_t num = size_t(-1));
+
+        //
+        // Status
+        //
+
+        size_t size() const { return container.size(); }
+        bool empty()  const { return container.empty(); }
+
+    private:
+
+        // the general case: one call per element
+        template <class C, class ... Args>
+        static void emplaceBack(C& c, Args&& ... args) { c.push_back(T(std::forward<Args>(args)...)); }
+        template <class C, class Iterator>
+        static void appendRange(C& c, Iterator first, Iterator last)
+        {
+            for (; first != last; ++first)
+                c.push_back(*first);
+        }
+        template <class C>
+        static void popFront(C& c, size_t num)
+        {
+            while (num--)
+                c.pop_front();
+        }
+        template <class C, class Out>
+        static void drainFront(C& c, Out& out, size_t num)
+        {
+            while (num--)
+            {
+                out.push_back(std::move(c.front()));
+                c.pop_front();
+            }
+        }
+
+        // a vector builds in place, reserves once and shifts once
+        template <size_t Align, bool Huge, class ... Args>
+        static void emplaceBack(vector<T, Align, Huge>& c, Args&& ... args) { c.emplace_back(std::forward<Args>(args)...); }
+        template <size_t Align, bool Huge, class Iterator>
+        static void appendRange(vector<T, Align, Huge>& c, Iterator first, Iterator last) { c.append(first, last); }
+        template <size_t Align, bool Huge>
+        static void popFront(vector<T, Align, Huge>& c, size_t num)
+        {
+            c.erase(c.begin(), typename vector<T, Align, Huge>::iterator(num, c));
+        }
+        template <size_t Align, bool Huge, class Out>
+        static void drainFront(vector<T, Align, Huge>& c, Out& out, size_t num)
+        {
+            for (size_t i = 0; i < num; i++)
+                out.push_back(std::move(c[i]));
+            popFront(c, num);
+        }
+
+        Container container;  // underlying container
+    };
+
+    /**************************************************
+     * QUEUE :: DRAIN INTO
+     * Move up to num elements, front first, onto the
+     * back of out, then pop them all at once
+     *     OUTPUT : the number of elements moved
+     **************************************************/
+    template <typename T, typename Container>
+    template <class Out>
+    size_t queue <T, Container> ::drain_into(Out& out, size_t num)
+    {
+        if (num > size())
+            num = size();
+
+        drainFront(container, out, num);
+        return num;
+    }
+
+    /**************************************************
+     * SWAP
+     * Swap the contents of two queues
+     **************************************************/
+    template <typename T, typename Container>
+    void swap(queue <T, Container>& lhs, queue <T, Container>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace custom
@@ -0,0 +1,536 @@
+/***********************************************************************
+ * Header:
+ *    SIMD
+ * Summary:
+ *    Vectorized search and reduction over custom::vector
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the definition of:
+ *        simd::find  : the first element equal to a value
+ *        simd::count : number of elements equal to a value
+ *        simd::min   : smallest element
+ *        simd::max   : largest element
+ *        simd::sum   : sum of all the elements
+ *        simd::dot   : dot product of two vectors
+ *
+ *    int, float and double use SSE2 or AVX2 (picked at runtime).
+ *    Every other type, and every other CPU, uses the scalar loop.
+ *    Floating point sums and dot products are accumulated lane by
+ *    lane, so the rounding can differ from the scalar loop.
+ *    Define CUSTOM_SIMD_DISABLE to always use the scalar loop.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>    // because I am paranoid
+#include <type_traits> // for std::true_type
+#include "vector.h"   // for vector
+
+#if !defined(CUSTOM_SIMD_DISABLE) && (defined(__x86_64__) || defined(_M_X64))
+#define CUSTOM_SIMD_X86
+#include <immintrin.h> // for the SSE2 and AVX2 intrinsics
+#ifdef _MSC_VER
+#include <intrin.h>    // for __cpuid
+#endif
+#endif
+
+// GCC and Clang need to be told which functions may use AVX2
+#if defined(__GNUC__)
+#define CUSTOM_SIMD_AVX2 __attribute__((target("avx2")))
+#else
+#define CUSTOM_SIMD_AVX2
+#endif
+
+namespace custom
+{
+namespace simd
+{
+    // which reduction to perform
+    struct Sum {};
+    struct Min {};
+    struct Max {};
+
+    /*****************************************
+     * SCALAR
+     * The plain loops. These work on any T and
+     * are also used for the tail of the SIMD loops.
+     ****************************************/
+    namespace scalar
+    {
+        template <typename T> T apply(Sum, const T& a, const T& b) { return a + b; }
+        template <typename T> T apply(Min, const T& a, const T& b) { return b < a ? b : a; }
+        template <typename T> T apply(Max, const T& a, const T& b) { return a < b ? b : a; }
+
+        template <typename T>
+        size_t find(const T* p, size_t n, const T& t)
+        {
+            for (size_t i = 0; i < n; i++)
+                if (p[i] == t)
+                    return i;
+            return n;
+        }
+
+        template <typename T>
+        size_t count(const T* p, size_t n, const T& t)
+        {
+            size_t c = 0;
+            for (size_t i = 0; i < n; i++)
+                if (p[i] == t)
+                    c++;
+            return c;
+        }
+
+        template <typename T, class Op>
+        T reduce(const T* p, size_t n, T acc, Op op)
+        {
+            for (size_t i = 0; i < n; i++)
+                acc = apply(op, acc, p[i]);
+            return acc;
+        }
+
+        template <typename T>
+        T dot(const T* a, const T* b, size_t n, T acc)
+        {
+            for (size_t i = 0; i < n; i++)
+                acc = acc + a[i] * b[i];
+            return acc;
+        }
+    } // namespace scalar
+
+#ifdef CUSTOM_SIMD_X86
+
+    /*****************************************
+     * LANE MASKS
+     * One bit per lane from a movemask
+     ****************************************/
+    inline size_t lowestBit(unsigned mask)
+    {
+        size_t i = 0;
+        while (!(mask & 1u))
+        {
+            mask >>= 1;
+            i++;
+        }
+        return i;
+    }
+
+    inline size_t countBits(unsigned mask)
+    {
+        size_t c = 0;
+        for (; mask; mask &= mask - 1)
+            c++;
+        return c;
+    }
+
+    /*****************************************
+     * HAS AVX2
+     * Ask the CPU (and the OS) once
+     ****************************************/
+    inline bool hasAvx2()
+    {
+#ifdef _MSC_VER
+        static const bool avx2 = []
+        {
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+            __cpuid(info, 1);
+            if (!(info[2] & (1 << 27)))            // OSXSAVE
+                return false;
+            if ((_xgetbv(0) & 6) != 6)             // OS saves the YMM registers
+                return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;      // AVX2
+        }();
+#else
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+        return avx2;
+    }
+
+    /*****************************************
+     * SSE2 LANES
+     * The 128 bit helpers for each element type.
+     * SSE2 is part of every x86-64 CPU.
+     ****************************************/
+    template <typename T> struct sse2;
+
+    template <>
+    struct sse2 <int>
+    {
+        using reg = __m128i;
+        static const size_t width = 4;
+        static reg load(const int* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static reg set1(int t) { return _mm_set1_epi32(t); }
+        static void store(int* p, reg a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a); }
+        static unsigned eq(reg a, reg b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+        static reg apply(Sum, reg a, reg b) { return _mm_add_epi32(a, b); }
+        static reg apply(Min, reg a, reg b)
+        {
+            reg gt = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+        }
+        static reg apply(Max, reg a, reg b)
+        {
+            reg gt = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+        }
+        static reg mul(reg a, reg b)
+        {
+            // SSE2 has no 32 bit multiply, so do the even and odd lanes separately
+            reg even = _mm_mul_epu32(a, b);
+            reg odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                      _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        }
+    };
+
+    template <>
+    struct sse2 <float>
+    {
+        using reg = __m128;
+        static const size_t width = 4;
+        static reg load(const float* p) { return _mm_loadu_ps(p); }
+        static reg set1(float t) { return _mm_set1_ps(t); }
+        static void store(float* p, reg a) { _mm_storeu_ps(p, a); }
+        static unsigned eq(reg a, reg b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+        static reg apply(Sum, reg a, reg b) { return _mm_add_ps(a, b); }
+        static reg apply(Min, reg a, reg b) { return _mm_min_ps(a, b); }
+        static reg apply(Max, reg a, reg b) { return _mm_max_ps(a, b); }
+        static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+    };
+
+    template <>
+    struct sse2 <double>
+    {
+        using reg = __m128d;
+        static const size_t width = 2;
+        static reg load(const double* p) { return _mm_loadu_pd(p); }
+        static reg set1(double t) { return _mm_set1_pd(t); }
+        static void store(double* p, reg a) { _mm_storeu_pd(p, a); }
+        static unsigned eq(reg a, reg b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+        static reg apply(Sum, reg a, reg b) { return _mm_add_pd(a, b); }
+        static reg apply(Min, reg a, reg b) { return _mm_min_pd(a, b); }
+        static reg apply(Max, reg a, reg b) { return _mm_max_pd(a, b); }
+        static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+    };
+
+    /*****************************************
+     * AVX2 LANES
+     * The 256 bit helpers for each element type
+     ****************************************/
+    template <typename T> struct avx2;
+
+    template <>
+    struct avx2 <int>
+    {
+        using reg = __m256i;
+        static const size_t width = 8;
+        CUSTOM_SIMD_AVX2 static reg load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        CUSTOM_SIMD_AVX2 static reg set1(int t) { return _mm256_set1_epi32(t); }
+        CUSTOM_SIMD_AVX2 static void store(int* p, reg a) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+        CUSTOM_SIMD_AVX2 static unsigned eq(reg a, reg b) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+        CUSTOM_SIMD_AVX2 static reg apply(Sum, reg a, reg b) { return _mm256_add_epi32(a, b); }
+        CUSTOM_SIMD_AVX2 static reg apply(Min, reg a, reg b) { return _mm256_min_epi32(a, b); }
+        CUSTOM_SIMD_AVX2 static reg apply(Max, reg a, reg b) { return _mm256_max_epi32(a, b); }
+        CUSTOM_SIMD_AVX2 static reg mul(reg a, reg b) { return _mm256_mullo_epi32(a, b); }
+    };
+
+    template <>
+    struct avx2 <float>
+    {
+        using reg = __m256;
+        static const size_t width = 8;
+        CUSTOM_SIMD_AVX2 static reg load(const float* p) { return _mm256_loadu_ps(p); }
+        CUSTOM_SIMD_AVX2 static reg set1(float t) { return _mm256_set1_ps(t); }
+        CUSTOM_SIMD_AVX2 static void store(float* p, reg a) { _mm256_storeu_ps(p, a); }
+        CUSTOM_SIMD_AVX2 static unsigned eq(reg a, reg b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+        CUSTOM_SIMD_AVX2 static reg apply(Sum, reg a, reg b) { return _mm256_add_ps(a, b); }
+        CUSTOM_SIMD_AVX2 static reg apply(Min, reg a, reg b) { return _mm256_min_ps(a, b); }
+        CUSTOM_SIMD_AVX2 static reg apply(Max, reg a, reg b) { return _mm256_max_ps(a, b); }
+        CUSTOM_SIMD_AVX2 static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+    };
+
+    template <>
+    struct avx2 <double>
+    {
+        using reg = __m256d;
+        static const size_t width = 4;
+        CUSTOM_SIMD_AVX2 static reg load(const double* p) { return _mm256_loadu_pd(p); }
+        CUSTOM_SIMD_AVX2 static reg set1(double t) { return _mm256_set1_pd(t); }
+        CUSTOM_SIMD_AVX2 static void store(double* p, reg a) { _mm256_storeu_pd(p, a); }
+        CUSTOM_SIMD_AVX2 static unsigned eq(reg a, reg b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+        CUSTOM_SIMD_AVX2 static reg apply(Sum, reg a, reg b) { return _mm256_add_pd(a, b); }
+        CUSTOM_SIMD_AVX2 static reg apply(Min, reg a, reg b) { return _mm256_min_pd(a, b); }
+        CUSTOM_SIMD_AVX2 static reg apply(Max, reg a, reg b) { return _mm256_max_pd(a, b); }
+        CUSTOM_SIMD_AVX2 static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+    };
+
+    /*****************************************
+     * KERNELS
+     * Written once against the lane helpers L.
+     * kernelAvx2 is the same code, but GCC and Clang
+     * must compile the whole loop with AVX2 enabled:
+     * a register cannot be handed between an AVX2
+     * function and a plain one without changing the ABI.
+     ****************************************/
+    namespace kernel
+    {
+        template <class L, typename T>
+        size_t find(const T* p, size_t n, T t)
+        {
+            typename L::reg needle = L::set1(t);
+            size_t i = 0;
+            for (; i + L::width <= n; i += L::width)
+            {
+                unsigned mask = L::eq(L::load(p + i), needle);
+                if (mask)
+                    return i + lowestBit(mask);
+            }
+            return i + scalar::find(p + i, n - i, t);
+        }
+
+        template <class L, typename T>
+        size_t count(const T* p, size_t n, T t)
+        {
+            typename L::reg needle = L::set1(t);
+            size_t c = 0;
+            size_t i = 0;
+            for (; i + L::width <= n; i += L::width)
+                c += countBits(L::eq(L::load(p + i), needle));
+            return c + scalar::count(p + i, n - i, t);
+        }
+
+        template <class L, typename T, class Op>
+        T reduce(const T* p, size_t n, T acc, Op op)
+        {
+            size_t i = 0;
+            if (n >= L::width)
+            {
+                typename L::reg lanes = L::load(p);
+                for (i = L::width; i + L::width <= n; i += L::width)
+                    lanes = L::apply(op, lanes, L::load(p + i));
+
+                T out[L::width];
+                L::store(out, lanes);
+                acc = scalar::reduce(out, L::width, acc, op);
+            }
+            return scalar::reduce(p + i, n - i, acc, op);
+        }
+
+        template <class L, typename T>
+        T dot(const T* a, const T* b, size_t n)
+        {
+            typename L::reg lanes = L::set1(T());
+            size_t i = 0;
+            for (; i + L::width <= n; i += L::width)
+                lanes = L::apply(Sum(), lanes, L::mul(L::load(a + i), L::load(b + i)));
+
+            T out[L::width];
+            L::store(out, lanes);
+            T acc = scalar::reduce(out, L::width, T(), Sum());
+            return scalar::dot(a + i, b + i, n - i, acc);
+        }
+    } // namespace kernel
+
+    namespace kernelAvx2
+    {
+        template <class L, typename T>
+        CUSTOM_SIMD_AVX2 size_t find(const T* p, size_t n, T t)
+        {
+            typename L::reg needle = L::set1(t);
+            size_t i = 0;
+            for (; i + L::width <= n; i += L::width)
+            {
+                unsigned mask = L::eq(L::load(p + i), needle);
+                if (mask)
+                    return i + lowestBit(mask);
+            }
+            return i + scalar::find(p + i, n - i, t);
+        }
+
+        template <class L, typename T>
+        CUSTOM_SIMD_AVX2 size_t count(const T* p, size_t n, T t)
+        {
+            typename L::reg needle = L::set1(t);
+            size_t c = 0;
+            size_t i = 0;
+            for (; i + L::width <= n; i += L::width)
+                c += countBits(L::eq(L::load(p + i), needle));
+            return c + scalar::count(p + i, n - i, t);
+        }
+
+        template <class L, typename T, class Op>
+        CUSTOM_SIMD_AVX2 T reduce(const T* p, size_t n, T acc, Op op)
+        {
+            size_t i = 0;
+            if (n >= L::width)
+            {
+                typename L::reg lanes = L::load(p);
+                for (i = L::width; i + L::width <= n; i += L::width)
+                    lanes = L::apply(op, lanes, L::load(p + i));
+
+                T out[L::width];
+                L::store(out, lanes);
+                acc = scalar::reduce(out, L::width, acc, op);
+            }
+            return scalar::reduce(p + i, n - i, acc, op);
+        }
+
+        template <class L, typename T>
+        CUSTOM_SIMD_AVX2 T dot(const T* a, const T* b, size_t n)
+        {
+            typename L::reg lanes = L::set1(T());
+            size_t i = 0;
+            for (; i + L::width <= n; i += L::width)
+                lanes = L::apply(Sum(), lanes, L::mul(L::load(a + i), L::load(b + i)));
+
+            T out[L::width];
+            L::store(out, lanes);
+            T acc = scalar::reduce(out, L::width, T(), Sum());
+            return scalar::dot(a + i, b + i, n - i, acc);
+        }
+    } // namespace kernelAvx2
+
+    /*****************************************
+     * DISPATCH
+     * int, float and double pick AVX2 or SSE2,
+     * everything else takes the scalar loop
+     ****************************************/
+    template <typename T> struct vectorized : std::false_type {};
+    template <> struct vectorized <int> : std::true_type {};
+    template <> struct vectorized <float> : std::true_type {};
+    template <> struct vectorized <double> : std::true_type {};
+
+    template <typename T>
+    size_t find(const T* p, size_t n, const T& t, std::false_type) { return scalar::find(p, n, t); }
+    template <typename T>
+    size_t find(const T* p, size_t n, const T& t, std::true_type)
+    {
+        return hasAvx2() ? kernelAvx2::find<avx2<T>>(p, n, t) : kernel::find<sse2<T>>(p, n, t);
+    }
+    template <typename T>
+    size_t find(const T* p, size_t n, const T& t) { return find(p, n, t, vectorized<T>()); }
+
+    template <typename T>
+    size_t count(const T* p, size_t n, const T& t, std::false_type) { return scalar::count(p, n, t); }
+    template <typename T>
+    size_t count(const T* p, size_t n, const T& t, std::true_type)
+    {
+        return hasAvx2() ? kernelAvx2::count<avx2<T>>(p, n, t) : kernel::count<sse2<T>>(p, n, t);
+    }
+    template <typename T>
+    size_t count(const T* p, size_t n, const T& t) { return count(p, n, t, vectorized<T>()); }
+
+    template <typename T, class Op>
+    T reduce(const T* p, size_t n, T acc, Op op, std::false_type) { return scalar::reduce(p, n, acc, op); }
+    template <typename T, class Op>
+    T reduce(const T* p, size_t n, T acc, Op op, std::true_type)
+    {
+        return hasAvx2() ? kernelAvx2::reduce<avx2<T>>(p, n, acc, op) : kernel::reduce<sse2<T>>(p, n, acc, op);
+    }
+    template <typename T, class Op>
+    T reduce(const T* p, size_t n, T acc, Op op) { return reduce(p, n, acc, op, vectorized<T>()); }
+
+    template <typename T>
+    T dot(const T* a, const T* b, size_t n, std::false_type) { return scalar::dot(a, b, n, T()); }
+    template <typename T>
+    T dot(const T* a, const T* b, size_t n, std::true_type)
+    {
+        return hasAvx2() ? kernelAvx2::dot<avx2<T>>(a, b, n) : kernel::dot<sse2<T>>(a, b, n);
+    }
+    template <typename T>
+    T dot(const T* a, const T* b, size_t n) { return dot(a, b, n, vectorized<T>()); }
+
+#else
+
+    template <typename T>
+    size_t find(const T* p, size_t n, const T& t) { return scalar::find(p, n, t); }
+
+    template <typename T>
+    size_t count(const T* p, size_t n, const T& t) { return scalar::count(p, n, t); }
+
+    template <typename T, class Op>
+    T reduce(const T* p, size_t n, T acc, Op op) { return scalar::reduce(p, n, acc, op); }
+
+    template <typename T>
+    T dot(const T* a, const T* b, size_t n) { return scalar::dot(a, b, n, T()); }
+
+#endif // CUSTOM_SIMD_X86
+
+    /*****************************************
+     * SIMD :: FIND
+     * Iterator to the first element equal to t,
+     * or end() if there is none
+     ****************************************/
+    template <typename T, size_t Align, bool Huge>
+    typename vector <T, Align, Huge> ::iterator find(vector <T, Align, Huge>& v, const T& t)
+    {
+        if (v.empty())
+            return v.end();
+        return typename vector <T, Align, Huge> ::iterator(find(&v.front(), v.size(), t), v);
+    }
+
+    /*****************************************
+     * SIMD :: COUNT
+     * Number of elements equal to t
+     ****************************************/
+    template <typename T, size_t Align, bool Huge>
+    size_t count(const vector <T, Align, Huge>& v, const T& t)
+    {
+        return v.empty() ? 0 : count(&v.front(), v.size(), t);
+    }
+
+    /*****************************************
+     * SIMD :: MIN and MAX
+     * Smallest and largest element. Throws on
+     * an empty vector, like priority_queue::top
+     ****************************************/
+    template <typename T, size_t Align, bool Huge>
+    T min(const vector <T, Align, Huge>& v)
+    {
+        if (v.empty())
+            throw "std:out_of_range";
+        return reduce(&v.front(), v.size(), v.front(), Min());
+    }
+
+    template <typename T, size_t Align, bool Huge>
+    T max(const vector <T, Align, Huge>& v)
+    {
+        if (v.empty())
+            throw "std:out_of_range";
+        return reduce(&v.front(), v.size(), v.front(), Max());
+    }
+
+    /*****************************************
+     * SIMD :: SUM
+     ****************************************/
+    template <typename T, size_t Align, bool Huge>
+    T sum(const vector <T, Align, Huge>& v)
+    {
+        return v.empty() ? T() : reduce(&v.front(), v.size(), T(), Sum());
+    }
+
+    /*****************************************
+     * SIMD :: DOT
+     * Both vectors must be the same size
+     ****************************************/
+    template <typename T, size_t Align, bool Huge>
+    T dot(const vector <T, Align, Huge>& lhs, const vector <T, Align, Huge>& rhs)
+    {
+        assert(lhs.size() == rhs.size());
+        return lhs.empty() ? T() : dot(&lhs.front(), &rhs.front(), lhs.size());
+    }
+
+} // namespace simd
+} // namespace custom
@@ -0,0 +1,476 @@
+/***********************************************************************
+ * Header:
+ *    SMALL VECTOR
+ * Summary:
+ *    A vector that keeps its first N elements inside the object itself
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        small_vector           : A vector with an inline buffer of N elements
+ *        small_vector::iterator : An interator through small_vector
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>           // because I am paranoid
+#include <new>               // std::bad_alloc and placement new
+#include <memory>            // for std::allocator
+#include <initializer_list>  // for std::initializer_list
+#include <utility>           // for std::move
+
+class TestSmallVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************
+     * SMALL VECTOR
+     * Same interface as custom::vector <T>, but the
+     * first N elements live in an inline buffer so
+     * small vectors never touch the heap.
+     ****************************************/
+    template <typename T, size_t N = 8>
+    class small_vector
+    {
+        friend class ::TestSmallVector; // give unit tests access to the privates
+    public:
+
+        //
+        // Construct
+        //
+
+        small_vector();
+        small_vector(size_t numElements);
+        small_vector(size_t numElements, const T& t);
+        small_vector(const std::initializer_list<T>& l);
+        small_vector(const small_vector& rhs);
+        small_vector(small_vector&& rhs);
+        ~small_vector();
+
+        //
+        // Assign
+        //
+
+        void swap(small_vector& rhs)
+        {
+            small_vector temp(std::move(rhs));
+            rhs = std::move(*this);
+            *this = std::move(temp);
+        }
+        small_vector& operator = (const small_vector& rhs);
+        small_vector& operator = (small_vector&& rhs);
+
+        //
+        // Iterator
+        //
+
+        class iterator;
+        iterator       begin() { return data; }
+        iterator       end() { return data + numElements; }
+
+        //
+        // Access
+        //
+
+        T& operator [] (size_t index) { return data[index]; }
+        const T& operator [] (size_t index) const { return data[index]; }
+        T& front() { return data[0]; }
+        const T& front() const { return data[0]; }
+        T& back() { return data[numElements - 1]; }
+        const T& back() const { return data[numElements - 1]; }
+
+        //
+        // Insert
+        //
+
+        void push_back(const T& t);
+        void push_back(T&& t);
+        void reserve(size_t newCapacity);
+        void resize(size_t newElements);
+        void resize(size_t newElements, const T& t);
+
+        //
+        // Remove
+        //
+
+        void clear()
+        {
+            destroy(0, numElements);
+            numElements = 0;
+        }
+        void pop_back()
+        {
+            if (numElements != 0)
+                data[--numElements].~T();
+        }
+        void shrink_to_fit();
+
+        //
+        // Status
+        //
+
+        size_t  size()          const { return numElements; }
+        size_t  capacity()      const { return numCapacity; }
+        bool empty()            const { return (numElements == 0); }
+        bool is_inline()        const { return data == inlineData(); }
+
+    private:
+
+        T* inlineData() { return reinterpret_cast<T*>(buffer); }
+        const T* inlineData() const { return reinterpret_cast<const T*>(buffer); }
+        void destroy(size_t iBegin, size_t iEnd);
+        void release();
+        void steal(small_vector& rhs);
+
+        alignas(T) unsigned char buffer[N * sizeof(T)]; // room for N elements, unconstructed
+        T* data;                   // either buffer or a heap allocation
+        size_t  numCapacity;       // the capacity of data
+        size_t  numElements;       // the number of items currently used
+    };
+
+    /**************************************************
+     * SMALL VECTOR ITERATOR
+     * An iterator through small_vector. Just like
+     * vector::iterator, this is a thin wrapper over a
+     * pointer so it works on either buffer.
+     *************************************************/
+    template <typename T, size_t N>
+    class small_vector <T, N> ::iterator
+    {
+        friend class ::TestSmallVector; // give unit tests access to the privates
+    public:
+        // constructors, destructors, and assignment operator
+        iterator() { this->p = nullptr; }
+        iterator(T* p) { this->p = p; }
+        iterator(const iterator& rhs) { this->p = rhs.p; }
+        iterator(size_t index, small_vector<T, N>& v) { this->p = (v.data + index); }
+        iterator& operator = (const iterator& rhs)
+        {
+            this->p = rhs.p;
+            return *this;
+        }
+
+        // equals, not equals operator
+        bool operator != (const iterator& rhs) const { return rhs.p != p; }
+        bool operator == (const iterator& rhs) const { return rhs.p == p; }
+
+        // dereference operator
+        T& operator * () { return *p; }
+
+        // prefix increment
+        iterator& operator ++ ()
+        {
+            p++;
+            return *this;
+        }
+
+        // postfix increment
+        iterator operator ++ (int)
+        {
+            iterator returnCopy(*this);
+            p++;
+            return returnCopy;
+        }
+
+        // prefix decrement
+        iterator& operator -- ()
+        {
+            p--;
+            return *this;
+        }
+
+        // postfix decrement
+        iterator operator -- (int)
+        {
+            iterator returnCopy(*this);
+            p--;
+            return returnCopy;
+        }
+
+    private:
+        T* p;
+    };
+
+    /*****************************************
+     * SMALL VECTOR :: DEFAULT constructors
+     * Start out pointing at the inline buffer
+     ****************************************/
+    template <typename T, size_t N>
+    small_vector <T, N> ::small_vector() : data(inlineData()), numCapacity(N), numElements(0)
+    {
+    }
+
+    /*****************************************
+     * SMALL VECTOR :: NON-DEFAULT constructors
+     * Value-initialize num elements
+     ****************************************/
+    template <typename T, size_t N>
+    small_vector <T, N> ::small_vector(size_t num) : small_vector()
+    {
+        resize(num);
+    }
+
+    template <typename T, size_t N>
+    small_vector <T, N> ::small_vector(size_t num, const T& t) : small_vector()
+    {
+        resize(num, t);
+    }
+
+    /*****************************************
+     * SMALL VECTOR :: INITIALIZATION LIST constructors
+     * Reserve once and copy-construct each element
+     ****************************************/
+    template <typename T, size_t N>
+    small_vector <T, N> ::small_vector(const std::initializer_list<T>& l) : small_vector()
+    {
+        reserve(l.size());
+        for (const T& t : l)
+            new (data + numElements++) T(t);
+    }
+
+    /*****************************************
+     * SMALL VECTOR :: COPY CONSTRUCTOR
+     ****************************************/
+    template <typename T, size_t N>
+    small_vector <T, N> ::small_vector(const small_vector& rhs) : small_vector()
+    {
+        *this = rhs;
+    }
+
+    /*****************************************
+     * SMALL VECTOR :: MOVE CONSTRUCTOR
+     * Steal the heap buffer if there is one,
+     * otherwise move the inline elements over
+     ****************************************/
+    template <typename T, size_t N>
+    small_vector <T, N> ::small_vector(small_vector&& rhs) : small_vector()
+    {
+        steal(rhs);
+    }
+
+    /*****************************************
+     * SMALL VECTOR :: DESTRUCTOR
+     ****************************************/
+    template <typename T, size_t N>
+    small_vector <T, N> :: ~small_vector()
+    {
+        clear();
+        release();
+    }
+
+    /***************************************
+     * SMALL VECTOR :: DESTROY
+     * Call the destructor on [iBegin, iEnd)
+     **************************************/
+    template <typename T, size_t N>
+    void small_vector <T, N> ::destroy(size_t iBegin, size_t iEnd)
+    {
+        for (size_t i = iBegin; i < iEnd; i++)
+            data[i].~T();
+    }
+
+    /***************************************
+     * SMALL VECTOR :: RELEASE
+     * Give back the heap buffer (if any) and
+     * go back to the inline buffer. Elements
+     * must already be destroyed.
+     **************************************/
+    template <typename T, size_t N>
+    void small_vector <T, N> ::release()
+    {
+        if (!is_inline())
+            std::allocator<T>().deallocate(data, numCapacity);
+        data = inlineData();
+        numCapacity = N;
+    }
+
+    /***************************************
+     * SMALL VECTOR :: STEAL
+     * Take the contents of rhs, leaving it empty.
+     * *this must be empty and inline.
+     **************************************/
+    template <typename T, size_t N>
+    void small_vector <T, N> ::steal(small_vector& rhs)
+    {
+        if (rhs.is_inline())
+        {
+            for (size_t i = 0; i < rhs.numElements; i++)
+                new (data + i) T(std::move(rhs.data[i]));
+            numElements = rhs.numElements;
+            rhs.clear();
+        }
+        else
+        {
+            data = rhs.data;
+            numCapacity = rhs.numCapacity;
+            numElements = rhs.numElements;
+
+            rhs.data = rhs.inlineData();
+            rhs.numCapacity = N;
+            rhs.numElements = 0;
+        }
+    }
+
+    /***************************************
+     * SMALL VECTOR :: RESIZE
+     * Grow or shrink to newElements
+     **************************************/
+    template <typename T, size_t N>
+    void small_vector <T, N> ::resize(size_t newElements)
+    {
+        if (newElements > numElements)
+        {
+            reserve(newElements);
+            for (; numElements < newElements; numElements++)
+                new (data + numElements) T();
+        }
+        else
+        {
+            destroy(newElements, numElements);
+            numElements = newElements;
+        }
+    }
+
+    template <typename T, size_t N>
+    void small_vector <T, N> ::resize(size_t newElements, const T& t)
+    {
+        if (newElements > numElements)
+        {
+            reserve(newElements);
+            for (; numElements < newElements; numElements++)
+                new (data + numElements) T(t);
+        }
+        else
+        {
+            destroy(newElements, numElements);
+            numElements = newElements;
+        }
+    }
+
+    /***************************************
+     * SMALL VECTOR :: RESERVE
+     * Spill to the heap once the inline buffer
+     * is no longer big enough. Elements are moved,
+     * not copied, into the new buffer.
+     **************************************/
+    template <typename T, size_t N>
+    void small_vector <T, N> ::reserve(size_t newCapacity)
+    {
+        if (newCapacity <= numCapacity)
+            return;
+
+        T* newBuffer = std::allocator<T>().allocate(newCapacity);
+        for (size_t i = 0; i < numElements; i++)
+        {
+            new (newBuffer + i) T(std::move(data[i]));
+            data[i].~T();
+        }
+
+        if (!is_inline())
+            std::allocator<T>().deallocate(data, numCapacity);
+        data = newBuffer;
+        numCapacity = newCapacity;
+    }
+
+    /***************************************
+     * SMALL VECTOR :: SHRINK TO FIT
+     * Come back inline when everything fits, otherwise
+     * trim the heap buffer down to numElements
+     **************************************/
+    template <typename T, size_t N>
+    void small_vector <T, N> ::shrink_to_fit()
+    {
+        if (is_inline() || numElements == numCapacity)
+            return;
+
+        T* oldBuffer = data;
+        size_t oldCapacity = numCapacity;
+        if (numElements <= N)
+        {
+            data = inlineData();
+            numCapacity = N;
+        }
+        else
+        {
+            data = std::allocator<T>().allocate(numElements);
+            numCapacity = numElements;
+        }
+
+        for (size_t i = 0; i < numElements; i++)
+        {
+            new (data + i) T(std::move(oldBuffer[i]));
+            oldBuffer[i].~T();
+        }
+        std::allocator<T>().deallocate(oldBuffer, oldCapacity);
+    }
+
+    /***************************************
+     * SMALL VECTOR :: PUSH BACK
+     * Add 't' to the end, doubling capacity as needed
+     **************************************/
+    template <typename T, size_t N>
+    void small_vector <T, N> ::push_back(const T& t)
+    {
+        if (numElements == numCapacity)
+        {
+            T copy(t);   // t may live inside the buffer we are about to move
+            reserve(numCapacity ? numCapacity * 2 : 1);
+            new (data + numElements++) T(std::move(copy));
+        }
+        else
+            new (data + numElements++) T(t);
+    }
+
+    template <typename T, size_t N>
+    void small_vector <T, N> ::push_back(T&& t)
+    {
+        if (numElements == numCapacity)
+        {
+            T moved(std::move(t));   // t may live inside the buffer we are about to move
+            reserve(numCapacity ? numCapacity * 2 : 1);
+            new (data + numElements++) T(std::move(moved));
+        }
+        else
+            new (data + numElements++) T(std::move(t));
+    }
+
+    /***************************************
+     * SMALL VECTOR :: ASSIGNMENT
+     * Copy the contents of rhs onto *this
+     **************************************/
+    template <typename T, size_t N>
+    small_vector <T, N>& small_vector <T, N> :: operator = (const small_vector& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        clear();
+        reserve(rhs.numElements);
+        for (size_t i = 0; i < rhs.numElements; i++)
+            new (data + i) T(rhs.data[i]);
+        numElements = rhs.numElements;
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    small_vector <T, N>& small_vector <T, N> :: operator = (small_vector&& rhs)
+    {
+        if (this == &rhs)
+            return *this;
+
+        clear();
+        release();
+        steal(rhs);
+        return *this;
+    }
+
+} // namespace custom
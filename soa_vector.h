@@ -0,0 +1,297 @@
+/***********************************************************************
+ * Header:
+ *    SOA VECTOR
+ * Summary:
+ *    A structure-of-arrays vector: one custom::vector per field
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *        soa_vector           : A vector of rows stored column by column
+ *        soa_vector::row      : A proxy for one row
+ *        soa_vector::iterator : An interator through the rows
+ *        column_span          : A contiguous view of one column
+ *
+ *    soa_vector<int, float, char> keeps every int in one array, every
+ *    float in another and every char in a third, so a loop that only
+ *    reads the floats only pulls floats into the cache. Each column is a
+ *    custom::vector; they are always grown together so they share the
+ *    same size and capacity.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <tuple>        // for std::tuple
+#include <utility>      // for std::index_sequence
+#include "vector.h"     // each column is a vector
+
+class TestSoaVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+    /*****************************************
+     * COLUMN SPAN
+     * A pointer and a length over one column.
+     * Good for as long as the soa_vector does
+     * not grow.
+     ****************************************/
+    template <typename T>
+    class column_span
+    {
+    public:
+        column_span() : p(nullptr), num(0) {}
+        column_span(T* p, size_t num) : p(p), num(num) {}
+
+        T* begin() const { return p; }
+        T* end() const { return p + num; }
+        T* data() const { return p; }
+        T& operator [] (size_t index) const { return p[index]; }
+        size_t size() const { return num; }
+        bool empty() const { return num == 0; }
+
+    private:
+        T* p;
+        size_t num;
+    };
+
+    /*****************************************
+     * SOA VECTOR
+     * A vector of (Ts...) rows stored as one
+     * contiguous array per field
+     ****************************************/
+    template <typename ... Ts>
+    class soa_vector
+    {
+        friend class ::TestSoaVector; // give unit tests access to the privates
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+        template <size_t I>
+        using column_type = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+        using indices = std::index_sequence_for<Ts...>;
+    public:
+
+        //
+        // Construct
+        //
+
+        soa_vector() {}
+        soa_vector(size_t numElements) { resize(numElements); }
+
+        //
+        // Assign
+        //
+
+        void swap(soa_vector& rhs) { swapColumns(rhs, indices()); }
+
+        //
+        // Iterator
+        //
+
+        class row;
+        class iterator;
+        iterator begin() { return iterator(0, this); }
+        iterator end() { return iterator(size(), this); }
+
+        //
+        // Access
+        //
+
+        row operator [] (size_t index) { return row(index, this); }
+        row front() { return row(0, this); }
+        row back() { return row(size() - 1, this); }
+
+        template <size_t I>
+        column_type<I>& get(size_t index) { return std::get<I>(columns)[index]; }
+
+        template <size_t I>
+        column_span<column_type<I>> column()
+        {
+            vector<column_type<I>>& v = std::get<I>(columns);
+            return v.empty() ? column_span<column_type<I>>() :
+                column_span<column_type<I>>(&v.front(), v.size());
+        }
+
+        //
+        // Insert
+        //
+
+        void push_back(const Ts& ... ts) { pushBack(indices(), ts...); }
+        void reserve(size_t newCapacity) { reserve(newCapacity, indices()); }
+        void resize(size_t newElements) { resize(newElements, indices()); }
+
+        //
+        // Remove
+        //
+
+        void clear() { clear(indices()); }
+        void pop_back() { popBack(indices()); }
+
+        //
+        // Status
+        //
+
+        size_t size()     const { return std::get<0>(columns).size(); }
+        size_t capacity() const { return std::get<0>(columns).capacity(); }
+        bool empty()      const { return size() == 0; }
+
+    private:
+
+        // apply the same call to every column
+        template <size_t ... I>
+        void pushBack(std::index_sequence<I...>, const Ts& ... ts)
+        {
+            // grow every column to the same capacity before adding
+            if (size() == capacity())
+                reserve(capacity() ? capacity() * 2 : 1);
+            int expand[] = { 0, (std::get<I>(columns).push_back(ts), 0)... };
+            (void)expand;
+        }
+        template <size_t ... I>
+        void reserve(size_t newCapacity, std::index_sequence<I...>)
+        {
+            int expand[] = { 0, (std::get<I>(columns).reserve(newCapacity), 0)... };
+            (void)expand;
+        }
+        template <size_t ... I>
+        void resize(size_t newElements, std::index_sequence<I...>)
+        {
+            int expand[] = { 0, (std::get<I>(columns).resize(newElements), 0)... };
+            (void)expand;
+        }
+        template <size_t ... I>
+        void clear(std::index_sequence<I...>)
+        {
+            int expand[] = { 0, (std::get<I>(columns).clear(), 0)... };
+            (void)expand;
+        }
+        template <size_t ... I>
+        void popBack(std::index_sequence<I...>)
+        {
+            int expand[] = { 0, (std::get<I>(columns).pop_back(), 0)... };
+            (void)expand;
+        }
+        template <size_t ... I>
+        void swapColumns(soa_vector& rhs, std::index_sequence<I...>)
+        {
+            int expand[] = { 0, (std::get<I>(columns).swap(std::get<I>(rhs.columns)), 0)... };
+            (void)expand;
+        }
+
+        std::tuple<vector<Ts>...> columns;   // one vector per field, all the same size
+    };
+
+    /**************************************************
+     * SOA VECTOR ROW
+     * A proxy for one row. get<I>() is a reference
+     * into column I, so writes go straight through.
+     *************************************************/
+    template <typename ... Ts>
+    class soa_vector <Ts...> ::row
+    {
+        friend class ::TestSoaVector; // give unit tests access to the privates
+    public:
+        row(size_t index, soa_vector* v) : index(index), v(v) {}
+        row(const row& rhs) : index(rhs.index), v(rhs.v) {}
+
+        template <size_t I>
+        column_type<I>& get() const { return v->template get<I>(index); }
+
+        // copy every field of rhs into this row
+        row& operator = (const std::tuple<Ts...>& rhs)
+        {
+            assign(rhs, indices());
+            return *this;
+        }
+        row& operator = (const row& rhs) { return *this = std::tuple<Ts...>(rhs); }
+        operator std::tuple<Ts...>() const { return values(indices()); }
+
+    private:
+        template <size_t ... I>
+        void assign(const std::tuple<Ts...>& rhs, std::index_sequence<I...>)
+        {
+            int expand[] = { 0, (get<I>() = std::get<I>(rhs), 0)... };
+            (void)expand;
+        }
+        template <size_t ... I>
+        std::tuple<Ts...> values(std::index_sequence<I...>) const
+        {
+            return std::tuple<Ts...>(get<I>()...);
+        }
+
+        size_t index;
+        soa_vector* v;
+    };
+
+    /**************************************************
+     * SOA VECTOR ITERATOR
+     * Walks the rows. Dereferencing gives a row proxy.
+     *************************************************/
+    template <typename ... Ts>
+    class soa_vector <Ts...> ::iterator
+    {
+        friend class ::TestSoaVector; // give unit tests access to the privates
+    public:
+        // constructors, destructors, and assignment operator
+        iterator() : index(0), v(nullptr) {}
+        iterator(size_t index, soa_vector* v) : index(index), v(v) {}
+        iterator(const iterator& rhs) : index(rhs.index), v(rhs.v) {}
+        iterator& operator = (const iterator& rhs)
+        {
+            index = rhs.index;
+            v = rhs.v;
+            return *this;
+        }
+
+        // equals, not equals operator
+        bool operator != (const iterator& rhs) const { return rhs.index != index; }
+        bool operator == (const iterator& rhs) const { return rhs.index == index; }
+
+        // dereference operator
+        row operator * () { return row(index, v); }
+
+        // prefix increment
+        iterator& operator ++ ()
+        {
+            index++;
+            return *this;
+        }
+
+        // postfix increment
+        iterator operator ++ (int)
+        {
+            iterator returnCopy(*this);
+            index++;
+            return returnCopy;
+        }
+
+        // prefix decrement
+        iterator& operator -- ()
+        {
+            index--;
+            return *this;
+        }
+
+        // postfix decrement
+        iterator operator -- (int)
+        {
+            iterator returnCopy(*this);
+            index--;
+            return returnCopy;
+        }
+
+    private:
+        size_t index;
+        soa_vector* v;
+    };
+
+} // namespace custom
@@ -0,0 +1,198 @@
+/***********************************************************************
+ * Header:
+ *    STACK
+ * Summary:
+ *    Our custom implementation of std::stack
+ *
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *
+ *    This will contain the class definition of:
+ *       stack             : similar to std::stack
+ *
+ *    Besides one-at-a-time push and pop, push_range, pop_n and drain_into
+ *    work on a whole batch. On a vector a batch costs one reservation or
+ *    one change to the size rather than one per element.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>      // because I am paranoid
+#include <utility>      // for std::move and std::forward
+#include "list.h"       // for copy_source
+#include "vector.h"     // the default container
+
+class TestStack;        // forward declaration for unit tests
+
+namespace custom
+{
+
+    /**************************************************
+     * STACK
+     * First-in-Last-out data structure, adapting
+     * any container with push_back, pop_back and back
+     **************************************************/
+    template <typename T, typename Container = vector<T>>
+    class stack
+    {
+        friend class ::TestStack; // give unit tests access to the privates
+    public:
+
+        //
+        // Construct
+        //
+
+        stack() {}
+        stack(const stack& rhs) : container(copy_source(rhs.container)) {}
+        stack(stack&& rhs) : container(std::move(rhs.container)) {}
+        explicit stack(const Container& rhs) : container(rhs) {}
+        explicit stack(Container&& rhs) : container(std::move(rhs)) {}
+        ~stack() {}
+
+        //
+        // Assign
+        //
+
+        stack& operator = (const stack& rhs)
+        {
+            container = copy_source(rhs.container);
+            return *this;
+        }
+        stack& operator = (stack&& rhs)
+        {
+            container = std::move(rhs.container);
+            return *this;
+        }
+        void swap(stack& rhs) { container.swap(rhs.container); }
+
+        //
+        // Access
+        //
+
+        T& top()
+        {
+            if (empty())
+                throw "std:out_of_range";
+            return container.back();
+        }
+        const T& top() const
+        {
+            if (empty())
+                throw "std:out_of_range";
+            return container.back();
+        }
+
+        //
+        // Insert
+        //
+
+        void push(const T& t) { container.push_back(t); }
+        void push(T&& t) { container.push_back(std::move(t)); }
+        template <class ... Args>
+        void emplace(Args&& ... args) { emplaceBack(container, std::forward<Args>(args)...); }
+        template <class Iterator>
+        void push_range(Iterator first, Iterator last) { appendRange(container, first, last); }
+
+        //
+        // Remove
+        //
+
+        void pop()
+        {
+            if (!empty())
+                container.pop_back();
+        }
+        void pop_n(size_t num) { popBack(container, num < size() ? num : size()); }
+        template <class Out>
+        size_t drain_into(Out& out, size_t num = size_t(-1));
+
+        //
+        // Status
+        //
+
+        size_t size() const { return container.size(); }
+        bool empty()  const { return container.empty(); }
+
+    private:
+
+        // the general case: one call per element
+        template <class C, class ... Args>
+        static void emplaceBack(C& c, Args&& ... args) { c.push_back(T(std::forward<Args>(args)...)); }
+        template <class C, class Iterator>
+        static void appendRange(C& c, Iterator first, Iterator last)
+        {
+            for (; first != last; ++first)
+                c.push_back(*first);
+        }
+        template <class C>
+        static void popBack(C& c, size_t num)
+        {
+            while (num--)
+                c.pop_back();
+        }
+        template <class C, class Out>
+        static void drainBack(C& c, Out& out, size_t num)
+        {
+            while (num--)
+            {
+                out.push_back(std::move(c.back()));
+                c.pop_back();
+            }
+        }
+
+        // a vector builds in place, reserves once and shrinks once
+        template <size_t Align, bool Huge, class ... Args>
+        static void emplaceBack(vector<T, Align, Huge>& c, Args&& ... args) { c.emplace_back(std::forward<Args>(args)...); }
+        template <size_t Align, bool Huge, class Iterator>
+        static void appendRange(vector<T, Align, Huge>& c, Iterator first, Iterator last) { c.append(first, last); }
+        template <size_t Align, bool Huge>
+        static void popBack(vector<T, Align, Huge>& c, size_t num)
+        {
+            c.erase(typename vector<T, Align, Huge>::iterator(c.size() - num, c), c.end());
+        }
+        template <size_t Align, bool Huge, class Out>
+        static void drainBack(vector<T, Align, Huge>& c, Out& out, size_t num)
+        {
+            for (size_t i = c.size(); i > c.size() - num; i--)
+                out.push_back(std::move(c[i - 1]));
+            popBack(c, num);
+        }
+
+        Container container;  // underlying container
+    };
+
+    /**************************************************
+     * STACK :: DRAIN INTO
+     * Move up to num elements, top first, onto the
+     * back of out, then pop them all at once
+     *     OUTPUT : the number of elements moved
+     **************************************************/
+    template <typename T, typename Container>
+    template <class Out>
+    size_t stack <T, Container> ::drain_into(Out& out, size_t num)
+    {
+        if (num > size())
+            num = size();
+
+        drainBack(container, out, num);
+        return num;
+    }
+
+    /**************************************************
+     * SWAP
+     * Swap the contents of two stacks
+     **************************************************/
+    template <typename T, typename Container>
+    void swap(stack <T, Container>& lhs, stack <T, Container>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+} // namespace custom
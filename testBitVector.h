@@ -0,0 +1,233 @@
+/***********************************************************************
+ * Header:
+ *    TEST BIT VECTOR
+ * Summary:
+ *    Unit tests for bit_vector
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "bit_vector.h"
+#include "unitTest.h"
+
+class TestBitVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_filled();
+
+      // Access
+      test_reference_assignBool();
+      test_reference_assignReference();
+
+      // Insert
+      test_pushBack_acrossWord();
+      test_resize_growTrue();
+
+      // Remove
+      test_popBack_clearsTail();
+
+      // Bit operations
+      test_flip_trims();
+      test_and_or_xor();
+
+      // Search
+      test_count_standard();
+      test_findFirst_empty();
+      test_findNext_acrossWords();
+
+      report("BitVector");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // 70 set bits take two words, and the tail of the second is clear
+   void test_construct_filled()
+   {  // exercise
+      custom::bit_vector b(70, true);
+      // verify
+      assertUnit(b.size() == 70);
+      assertUnit(b.words.size() == 2);
+      assertUnit(b.words[0] == ~uint64_t(0));
+      assertUnit(b.words[1] == 0x3F);
+   }  // teardown
+
+   /***************************************
+    * REFERENCE
+    ***************************************/
+
+   // writing through operator [] sets and clears one bit
+   void test_reference_assignBool()
+   {  // setup
+      custom::bit_vector b(10);
+      // exercise
+      b[3] = true;
+      b[4] = true;
+      b[4] = false;
+      // verify
+      assertUnit(b.test(3));
+      assertUnit(!b.test(4));
+      assertUnit(b.words[0] == 0x8);
+   }  // teardown
+
+   // assigning one bit to another copies the value, not the proxy
+   void test_reference_assignReference()
+   {  // setup
+      custom::bit_vector b(10);
+      b.set(7);
+      // exercise
+      b[2] = b[7];
+      // verify
+      assertUnit(b.test(2));
+      assertUnit(b.test(7));
+      assertUnit(b.count() == 2);
+   }  // teardown
+
+   /***************************************
+    * PUSH BACK and RESIZE
+    ***************************************/
+
+   // the 65th bit starts a new word
+   void test_pushBack_acrossWord()
+   {  // setup
+      custom::bit_vector b(64);
+      // exercise
+      b.push_back(true);
+      // verify
+      assertUnit(b.size() == 65);
+      assertUnit(b.words.size() == 2);
+      assertUnit(b.test(64));
+      assertUnit(b.count() == 1);
+   }  // teardown
+
+   // growing with true sets only the new bits
+   void test_resize_growTrue()
+   {  // setup
+      custom::bit_vector b(3);
+      // exercise
+      b.resize(100, true);
+      // verify
+      assertUnit(!b.test(0));
+      assertUnit(!b.test(2));
+      assertUnit(b.test(3));
+      assertUnit(b.test(99));
+      assertUnit(b.count() == 97);
+   }  // teardown
+
+   /***************************************
+    * POP BACK
+    ***************************************/
+
+   // a popped bit does not come back when the vector grows
+   void test_popBack_clearsTail()
+   {  // setup
+      custom::bit_vector b(5, true);
+      // exercise
+      b.pop_back();
+      b.push_back(false);
+      // verify
+      assertUnit(b.size() == 5);
+      assertUnit(!b.test(4));
+      assertUnit(b.count() == 4);
+   }  // teardown
+
+   /***************************************
+    * BIT OPERATIONS
+    ***************************************/
+
+   // flip never turns on bits past the end
+   void test_flip_trims()
+   {  // setup
+      custom::bit_vector b(70);
+      b.set(0);
+      // exercise
+      b.flip();
+      // verify
+      assertUnit(!b.test(0));
+      assertUnit(b.count() == 69);
+      assertUnit(b.words[1] == 0x3F);
+   }  // teardown
+
+   // and, or, xor word by word
+   void test_and_or_xor()
+   {  // setup
+      custom::bit_vector a(100);
+      custom::bit_vector b(100);
+      a.set(1);
+      a.set(70);
+      b.set(70);
+      b.set(99);
+      custom::bit_vector bAnd(a);
+      custom::bit_vector bOr(a);
+      custom::bit_vector bXor(a);
+      // exercise
+      bAnd &= b;
+      bOr |= b;
+      bXor ^= b;
+      // verify
+      assertUnit(bAnd.count() == 1 && bAnd.test(70));
+      assertUnit(bOr.count() == 3);
+      assertUnit(bXor.count() == 2 && bXor.test(1) && bXor.test(99));
+   }  // teardown
+
+   /***************************************
+    * SEARCH
+    ***************************************/
+
+   // count the set bits in three words
+   void test_count_standard()
+   {  // setup
+      custom::bit_vector b(150);
+      b.set(0);
+      b.set(64);
+      b.set(149);
+      // exercise
+      size_t c = b.count();
+      // verify
+      assertUnit(c == 3);
+   }  // teardown
+
+   // no set bit means size()
+   void test_findFirst_empty()
+   {  // setup
+      custom::bit_vector b(130);
+      // exercise
+      size_t i = b.find_first();
+      // verify
+      assertUnit(i == 130);
+   }  // teardown
+
+   // walk the set bits across words
+   void test_findNext_acrossWords()
+   {  // setup
+      custom::bit_vector b(200);
+      b.set(5);
+      b.set(63);
+      b.set(64);
+      b.set(190);
+      // exercise
+      size_t i0 = b.find_first();
+      size_t i1 = b.find_next(i0);
+      size_t i2 = b.find_next(i1);
+      size_t i3 = b.find_next(i2);
+      size_t i4 = b.find_next(i3);
+      // verify
+      assertUnit(i0 == 5);
+      assertUnit(i1 == 63);
+      assertUnit(i2 == 64);
+      assertUnit(i3 == 190);
+      assertUnit(i4 == 200);
+   }  // teardown
+};
+
+#endif // DEBUG
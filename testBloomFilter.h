@@ -0,0 +1,180 @@
+/***********************************************************************
+ * Header:
+ *    TEST BLOOM FILTER
+ * Summary:
+ *    Unit tests for blocked_bloom_filter
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "bloom_filter.h"
+#include "unitTest.h"
+#include <functional>
+
+class TestBloomFilter : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sized();
+
+      // Assign
+      test_swap_standard();
+
+      // Access
+      test_mightContain_empty();
+      test_mightContain_noFalseNegatives();
+      test_mightContain_fewFalsePositives();
+
+      // Insert
+      test_insert_oneBlock();
+
+      // Remove
+      test_clear_keepsBlocks();
+
+      report("BloomFilter");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // no blocks at all
+   void test_construct_default()
+   {  // exercise
+      custom::blocked_bloom_filter f;
+      // verify
+      assertUnit(f.empty());
+      assertUnit(f.block_count() == 0);
+   }  // teardown
+
+   // 1000 keys at 16 bits each need 32 blocks of 512 bits
+   void test_construct_sized()
+   {  // exercise
+      custom::blocked_bloom_filter f(1000);
+      // verify
+      assertUnit(f.block_count() == 32);
+      assertUnit(f.blockBits == 5);
+      assertUnit(f.words.size() == 32 * 8);
+   }  // teardown
+
+   /***************************************
+    * SWAP
+    ***************************************/
+
+   // trade blocks with an empty filter
+   void test_swap_standard()
+   {  // setup
+      custom::blocked_bloom_filter f1(1000);
+      custom::blocked_bloom_filter f2;
+      f1.insert(26);
+      // exercise
+      f1.swap(f2);
+      // verify
+      assertUnit(f1.empty());
+      assertUnit(f2.block_count() == 32);
+      assertUnit(f2.might_contain(26));
+   }  // teardown
+
+   /***************************************
+    * MIGHT CONTAIN
+    ***************************************/
+
+   // a filter with no blocks rules nothing out
+   void test_mightContain_empty()
+   {  // setup
+      custom::blocked_bloom_filter f;
+      // exercise
+      bool maybe = f.might_contain(26);
+      // verify
+      assertUnit(maybe);
+   }  // teardown
+
+   // everything inserted is reported
+   void test_mightContain_noFalseNegatives()
+   {  // setup
+      custom::blocked_bloom_filter f(1000);
+      std::hash<int> hasher;
+      for (int i = 0; i < 1000; i++)
+         f.insert(hasher(i));
+      // exercise
+      bool all = true;
+      for (int i = 0; i < 1000; i++)
+         all = all && f.might_contain(hasher(i));
+      // verify
+      assertUnit(all);
+   }  // teardown
+
+   // well under one percent of the rest get a false maybe
+   void test_mightContain_fewFalsePositives()
+   {  // setup
+      custom::blocked_bloom_filter f(1000);
+      std::hash<int> hasher;
+      for (int i = 0; i < 1000; i++)
+         f.insert(hasher(i));
+      // exercise
+      int numMaybe = 0;
+      for (int i = 1000; i < 101000; i++)
+         if (f.might_contain(hasher(i)))
+            numMaybe++;
+      // verify
+      assertUnit(numMaybe < 1000);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // one hash sets one bit in each word of one block
+   void test_insert_oneBlock()
+   {  // setup
+      custom::blocked_bloom_filter f(1000);
+      // exercise
+      f.insert(26);
+      // verify
+      size_t numBlocks = 0;
+      bool oneBitEach = true;
+      for (size_t b = 0; b < f.block_count(); b++)
+      {
+         bool touched = false;
+         for (size_t j = 0; j < 8; j++)
+            touched = touched || f.words[b * 8 + j] != 0;
+         if (!touched)
+            continue;
+         numBlocks++;
+         for (size_t j = 0; j < 8; j++)
+         {
+            uint64_t word = f.words[b * 8 + j];
+            oneBitEach = oneBitEach && word != 0 && (word & (word - 1)) == 0;
+         }
+      }
+      assertUnit(numBlocks == 1);
+      assertUnit(oneBitEach);
+   }  // teardown
+
+   /***************************************
+    * CLEAR
+    ***************************************/
+
+   // clear forgets every hash but not the size
+   void test_clear_keepsBlocks()
+   {  // setup
+      custom::blocked_bloom_filter f(1000);
+      f.insert(26);
+      // exercise
+      f.clear();
+      // verify
+      assertUnit(f.block_count() == 32);
+      assertUnit(!f.might_contain(26));
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,241 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT UNORDERED SET
+ * Summary:
+ *    Unit tests for concurrent_unordered_set
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrent_unordered_set.h"
+#include "unitTest.h"
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+class TestConcurrentUnorderedSet : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_roundsUp();
+
+      // Access
+      test_contains_standard();
+      test_contains_hashesOnce();
+      test_forEach_standard();
+
+      // Insert
+      test_insert_duplicate();
+      test_insert_spreadsShards();
+      test_insert_threads();
+
+      // Remove
+      test_erase_standard();
+      test_clear_standard();
+
+      report("ConcurrentUnorderedSet");
+   }
+
+   // std::hash, counting how often it is called
+   struct CountingHash
+   {
+      CountingHash(int* pNumCalls = nullptr) : pNumCalls(pNumCalls) {}
+      size_t operator () (int key) const
+      {
+         if (pNumCalls)
+            (*pNumCalls)++;
+         return std::hash<int>()(key);
+      }
+      int* pNumCalls;
+   };
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // some shards, all empty, none growing a little at a time
+   void test_construct_default()
+   {  // exercise
+      custom::concurrent_unordered_set<int> s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.shard_count() >= 4);
+      assertUnit((s.shard_count() & (s.shard_count() - 1)) == 0);
+      bool incremental = false;
+      for (size_t i = 0; i < s.shard_count(); i++)
+         incremental = incremental || s.shards[i].set.incremental_rehash();
+      assertUnit(!incremental);
+   }  // teardown
+
+   // five shards becomes eight, each starting a cache line
+   void test_construct_roundsUp()
+   {  // exercise
+      custom::concurrent_unordered_set<int> s(5);
+      // verify
+      assertUnit(s.shard_count() == 8);
+      assertUnit(s.shardBits == 3);
+      assertUnit(reinterpret_cast<uintptr_t>(s.shards) % 64 == 0);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // contains and count through const
+   void test_contains_standard()
+   {  // setup
+      custom::concurrent_unordered_set<int> s(4);
+      setupStandardFixture(s);
+      const custom::concurrent_unordered_set<int>& sConst = s;
+      // exercise
+      bool found = sConst.contains(26);
+      bool missing = !sConst.contains(99);
+      size_t num = sConst.count(31);
+      // verify
+      assertUnit(found);
+      assertUnit(missing);
+      assertUnit(num == 1);
+   }  // teardown
+
+   // one hash picks both the shard and the bucket
+   void test_contains_hashesOnce()
+   {  // setup
+      int numCalls = 0;
+      custom::concurrent_unordered_set<int, CountingHash> s(4, CountingHash(&numCalls));
+      setupStandardFixture(s);
+      numCalls = 0;
+      // exercise
+      s.contains(26);
+      s.contains(99);
+      s.insert(42);
+      s.erase(11);
+      // verify
+      assertUnit(numCalls == 4);
+   }  // teardown
+
+   // visit each element once
+   void test_forEach_standard()
+   {  // setup
+      custom::concurrent_unordered_set<int> s(4);
+      setupStandardFixture(s);
+      int sum = 0;
+      size_t num = 0;
+      // exercise
+      s.for_each([&](const int& value) { sum += value; num++; });
+      // verify
+      assertUnit(num == 3);
+      assertUnit(sum == 11 + 26 + 31);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // a second insert of the same key reports false
+   void test_insert_duplicate()
+   {  // setup
+      custom::concurrent_unordered_set<int> s(4);
+      setupStandardFixture(s);
+      // exercise
+      bool added = s.insert(26);
+      // verify
+      assertUnit(!added);
+      assertUnit(s.size() == 3);
+   }  // teardown
+
+   // std::hash of small ints still reaches every shard
+   void test_insert_spreadsShards()
+   {  // setup
+      custom::concurrent_unordered_set<int> s(8);
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         s.insert(i);
+      // verify
+      assertUnit(s.size() == 1000);
+      bool everyShard = true;
+      for (size_t i = 0; i < s.shard_count(); i++)
+         everyShard = everyShard && !s.shards[i].set.empty();
+      assertUnit(everyShard);
+   }  // teardown
+
+   // four writers and a reader at once lose nothing
+   void test_insert_threads()
+   {  // setup
+      custom::concurrent_unordered_set<int> s(16);
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.push_back(std::thread([&s, t]()
+         {
+            for (int i = 0; i < 1000; i++)
+               s.insert(t * 1000 + i);
+         }));
+      threads.push_back(std::thread([&s]()
+      {
+         for (int i = 0; i < 4000; i++)
+            s.contains(i);
+      }));
+      for (size_t t = 0; t < threads.size(); t++)
+         threads[t].join();
+      // verify
+      assertUnit(s.size() == 4000);
+      bool all = true;
+      for (int i = 0; i < 4000; i++)
+         all = all && s.contains(i);
+      assertUnit(all);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase reports whether the key was there
+   void test_erase_standard()
+   {  // setup
+      custom::concurrent_unordered_set<int> s(4);
+      setupStandardFixture(s);
+      // exercise
+      bool erased = s.erase(26);
+      bool erasedAgain = s.erase(26);
+      // verify
+      assertUnit(erased);
+      assertUnit(!erasedAgain);
+      assertUnit(s.size() == 2);
+      assertUnit(!s.contains(26));
+   }  // teardown
+
+   // clear empties every shard
+   void test_clear_standard()
+   {  // setup
+      custom::concurrent_unordered_set<int> s(4);
+      setupStandardFixture(s);
+      // exercise
+      s.clear();
+      // verify
+      assertUnit(s.empty());
+      assertUnit(!s.contains(11));
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   template <class Set>
+   void setupStandardFixture(Set& s)
+   {
+      s.insert(11);
+      s.insert(26);
+      s.insert(31);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,207 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT VECTOR
+ * Summary:
+ *    Unit tests for concurrent_vector
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrent_vector.h"
+#include "unitTest.h"
+#include <thread>
+#include <vector>
+
+class TestConcurrentVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+
+      // Insert
+      test_pushBack_index();
+      test_pushBack_addressesStay();
+      test_growBy_acrossSegments();
+      test_pushBack_threads();
+
+      // Remove
+      test_clear_keepsSegments();
+
+      // Status
+      test_capacity_laterSegmentFirst();
+
+      report("ConcurrentVector");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing is allocated until the first push_back
+   void test_construct_default()
+   {  // exercise
+      custom::concurrent_vector<int> v;
+      // verify
+      assertUnit(v.empty());
+      assertUnit(v.capacity() == 0);
+      assertUnit(v.segments[0].load() == nullptr);
+   }  // teardown
+
+   // copy a vector of three
+   void test_constructCopy_standard()
+   {  // setup
+      custom::concurrent_vector<int> vSrc;
+      setupStandardFixture(vSrc);
+      // exercise
+      custom::concurrent_vector<int> vDest(vSrc);
+      // verify
+      assertStandardFixture(vSrc);
+      assertStandardFixture(vDest);
+   }  // teardown
+
+   /***************************************
+    * PUSH BACK
+    ***************************************/
+
+   // push_back hands back the index it claimed
+   void test_pushBack_index()
+   {  // setup
+      custom::concurrent_vector<int> v;
+      // exercise
+      size_t i0 = v.push_back(11);
+      size_t i1 = v.push_back(26);
+      size_t i2 = v.push_back(31);
+      // verify
+      assertUnit(i0 == 0);
+      assertUnit(i1 == 1);
+      assertUnit(i2 == 2);
+      assertStandardFixture(v);
+   }  // teardown
+
+   // growing adds segments but never moves an element
+   void test_pushBack_addressesStay()
+   {  // setup
+      custom::concurrent_vector<int> v;
+      v.push_back(11);
+      int* p = &v[0];
+      // exercise
+      for (int i = 1; i < 100; i++)
+         v.push_back(i);
+      // verify
+      assertUnit(&v[0] == p);
+      assertUnit(v[0] == 11);
+      assertUnit(v[99] == 99);
+      assertUnit(v.capacity() >= 100);
+   }  // teardown
+
+   // grow_by fills a run that spans three segments
+   void test_growBy_acrossSegments()
+   {  // setup
+      custom::concurrent_vector<int> v;
+      v.push_back(11);
+      // exercise
+      size_t first = v.grow_by(30, 26);
+      // verify
+      assertUnit(first == 1);
+      assertUnit(v.size() == 31);
+      assertUnit(v[1] == 26);
+      assertUnit(v[7] == 26);
+      assertUnit(v[8] == 26);
+      assertUnit(v[30] == 26);
+      assertUnit(v.segments[2].load() != nullptr);
+   }  // teardown
+
+   // four threads appending at once lose nothing
+   void test_pushBack_threads()
+   {  // setup
+      custom::concurrent_vector<int> v;
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.push_back(std::thread([&v, t]()
+         {
+            for (int i = 0; i < 1000; i++)
+               v.push_back(t * 1000 + i);
+         }));
+      for (auto& thread : threads)
+         thread.join();
+      // verify
+      assertUnit(v.size() == 4000);
+      std::vector<bool> seen(4000, false);
+      for (size_t i = 0; i < v.size(); i++)
+         seen[v[i]] = true;
+      bool all = true;
+      for (size_t i = 0; i < seen.size(); i++)
+         all = all && seen[i];
+      assertUnit(all);
+   }  // teardown
+
+   /***************************************
+    * CLEAR
+    ***************************************/
+
+   // clear destroys the elements but keeps the memory
+   void test_clear_keepsSegments()
+   {  // setup
+      custom::concurrent_vector<int> v;
+      setupStandardFixture(v);
+      size_t capacity = v.capacity();
+      // exercise
+      v.clear();
+      // verify
+      assertUnit(v.empty());
+      assertUnit(v.capacity() == capacity);
+   }  // teardown
+
+   /***************************************
+    * CAPACITY
+    ***************************************/
+
+   // a later segment allocated before an earlier one still counts
+   void test_capacity_laterSegmentFirst()
+   {  // setup
+      custom::concurrent_vector<int> v;
+      // exercise
+      v.allocateSegment(2);
+      // verify
+      assertUnit(v.segments[0].load() == nullptr);
+      assertUnit(v.capacity() == 56);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   void setupStandardFixture(custom::concurrent_vector<int>& v)
+   {
+      v.push_back(11);
+      v.push_back(26);
+      v.push_back(31);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::concurrent_vector<int>& v, int line, const char* function)
+   {
+      assertIndirect(v.size() == 3);
+      if (v.size() == 3)
+      {
+         assertIndirect(v[0] == 11);
+         assertIndirect(v[1] == 26);
+         assertIndirect(v[2] == 31);
+      }
+   }
+};
+
+#endif // DEBUG
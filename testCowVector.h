@@ -0,0 +1,218 @@
+/***********************************************************************
+ * Header:
+ *    TEST COW VECTOR
+ * Summary:
+ *    Unit tests for cow_vector
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "cow_vector.h"
+#include "unitTest.h"
+
+class TestCowVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_constructCopy_shares();
+      test_constructCopy_afterMove();
+      test_constructMove_standard();
+
+      // Assign
+      test_assign_afterMove();
+      test_assign_self();
+
+      // Access
+      test_read_constDoesNotClone();
+      test_write_clones();
+      test_write_afterMove();
+      test_reference_thenCopy();
+      test_clear_shareableAgain();
+
+      report("CowVector");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a copy shares the buffer
+   void test_constructCopy_shares()
+   {  // setup
+      custom::cow_vector<int> vSrc;
+      setupStandardFixture(vSrc);
+      // exercise
+      custom::cow_vector<int> vDest(vSrc);
+      // verify
+      assertUnit(vDest.pBlock == vSrc.pBlock);
+      assertUnit(vSrc.use_count() == 2);
+      assertStandardFixture(vDest);
+   }  // teardown
+
+   // a copy of a moved-from vector is empty
+   void test_constructCopy_afterMove()
+   {  // setup
+      custom::cow_vector<int> vSrc;
+      setupStandardFixture(vSrc);
+      custom::cow_vector<int> vMoved(std::move(vSrc));
+      // exercise
+      custom::cow_vector<int> vDest(vSrc);
+      // verify
+      assertUnit(vDest.empty());
+      assertUnit(vDest.use_count() == 0);
+      assertStandardFixture(vMoved);
+   }  // teardown
+
+   // moving takes the buffer and leaves nothing behind
+   void test_constructMove_standard()
+   {  // setup
+      custom::cow_vector<int> vSrc;
+      setupStandardFixture(vSrc);
+      // exercise
+      custom::cow_vector<int> vDest(std::move(vSrc));
+      // verify
+      assertUnit(vSrc.pBlock == nullptr);
+      assertUnit(vSrc.empty());
+      assertUnit(vDest.use_count() == 1);
+      assertStandardFixture(vDest);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign from a moved-from vector
+   void test_assign_afterMove()
+   {  // setup
+      custom::cow_vector<int> vSrc;
+      custom::cow_vector<int> vMoved(std::move(vSrc));
+      custom::cow_vector<int> vDest;
+      setupStandardFixture(vDest);
+      // exercise
+      vDest = vSrc;
+      // verify
+      assertUnit(vDest.empty());
+   }  // teardown
+
+   // assign to itself
+   void test_assign_self()
+   {  // setup
+      custom::cow_vector<int> v;
+      setupStandardFixture(v);
+      custom::cow_vector<int>& vAlias = v;
+      // exercise
+      v = vAlias;
+      // verify
+      assertUnit(v.use_count() == 1);
+      assertStandardFixture(v);
+   }  // teardown
+
+   /***************************************
+    * READ and WRITE
+    ***************************************/
+
+   // reading through const never clones
+   void test_read_constDoesNotClone()
+   {  // setup
+      custom::cow_vector<int> vSrc;
+      setupStandardFixture(vSrc);
+      const custom::cow_vector<int> vDest(vSrc);
+      // exercise
+      int value = vDest[1];
+      // verify
+      assertUnit(value == 26);
+      assertUnit(vDest.pBlock == vSrc.pBlock);
+   }  // teardown
+
+   // the first write to a shared buffer clones it
+   void test_write_clones()
+   {  // setup
+      custom::cow_vector<int> vSrc;
+      setupStandardFixture(vSrc);
+      custom::cow_vector<int> vDest(vSrc);
+      // exercise
+      vDest.push_back(99);
+      // verify
+      assertUnit(vDest.pBlock != vSrc.pBlock);
+      assertUnit(vSrc.use_count() == 1);
+      assertUnit(vDest.size() == 4);
+      assertStandardFixture(vSrc);
+   }  // teardown
+
+   // a moved-from vector can be written again
+   void test_write_afterMove()
+   {  // setup
+      custom::cow_vector<int> vSrc;
+      custom::cow_vector<int> vMoved(std::move(vSrc));
+      // exercise
+      setupStandardFixture(vSrc);
+      // verify
+      assertStandardFixture(vSrc);
+   }  // teardown
+
+   // a reference handed out before a copy does not write into the copy
+   void test_reference_thenCopy()
+   {  // setup
+      custom::cow_vector<int> vSrc;
+      setupStandardFixture(vSrc);
+      int& r = vSrc[0];
+      // exercise
+      custom::cow_vector<int> vDest(vSrc);
+      r = 99;
+      // verify
+      assertUnit(vSrc.pBlock != vDest.pBlock);
+      assertUnit(vSrc[0] == 99);
+      assertStandardFixture(vDest);
+   }  // teardown
+
+   // after clear the buffer is shared again
+   void test_clear_shareableAgain()
+   {  // setup
+      custom::cow_vector<int> vSrc;
+      setupStandardFixture(vSrc);
+      vSrc.front();
+      // exercise
+      vSrc.clear();
+      vSrc.push_back(11);
+      custom::cow_vector<int> vDest(vSrc);
+      // verify
+      assertUnit(vSrc.pBlock == vDest.pBlock);
+      assertUnit(vDest.size() == 1);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   void setupStandardFixture(custom::cow_vector<int>& v)
+   {
+      v.push_back(11);
+      v.push_back(26);
+      v.push_back(31);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    11 26 31, read through const so nothing is cloned
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::cow_vector<int>& v, int line, const char* function)
+   {
+      assertIndirect(v.size() == 3);
+      if (v.size() == 3)
+      {
+         assertIndirect(v[0] == 11);
+         assertIndirect(v[1] == 26);
+         assertIndirect(v[2] == 31);
+      }
+   }
+};
+
+#endif // DEBUG
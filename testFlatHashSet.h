@@ -0,0 +1,212 @@
+/***********************************************************************
+ * Header:
+ *    TEST FLAT HASH SET
+ * Summary:
+ *    Unit tests for flat_hash_set
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "flat_hash_set.h"
+#include "unitTest.h"
+#include <string>
+
+class TestFlatHashSet : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+
+      // Insert
+      test_insert_standard();
+      test_insert_duplicate();
+      test_insert_grow();
+
+      // Remove
+      test_erase_leavesEmpty();
+      test_erase_leavesTombstone();
+      test_insert_reusesTombstone();
+      test_rehash_sweepsTombstones();
+
+      report("FlatHashSet");
+   }
+
+   // every key collides, so they all probe the same groups in order
+   struct CollidingHash
+   {
+      size_t operator () (int) const { return 0; }
+   };
+   typedef custom::flat_hash_set<int, CollidingHash> CollidingSet;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // no slots until the first insert
+   void test_construct_default()
+   {  // exercise
+      custom::flat_hash_set<int> s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.bucket_count() == 0);
+      assertUnit(!s.contains(11));
+      assertUnit(s.find(11) == s.end());
+   }  // teardown
+
+   // a copy holds the same elements in its own slots
+   void test_constructCopy_standard()
+   {  // setup
+      custom::flat_hash_set<std::string> sSrc{ "eleven", "twenty-six", "thirty-one" };
+      // exercise
+      custom::flat_hash_set<std::string> sDest(sSrc);
+      // verify
+      assertUnit(sDest.size() == 3);
+      assertUnit(sDest.contains("twenty-six"));
+      assertUnit(sDest.slots != sSrc.slots);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // insert three and find them again
+   void test_insert_standard()
+   {  // setup
+      custom::flat_hash_set<int> s;
+      // exercise
+      custom::pair<custom::flat_hash_set<int>::iterator, bool> result = s.insert(26);
+      s.insert(11);
+      s.insert(31);
+      // verify
+      assertUnit(result.second);
+      assertUnit(*result.first == 26);
+      assertUnit(s.size() == 3);
+      assertUnit(s.contains(11) && s.contains(26) && s.contains(31));
+      assertUnit(!s.contains(99));
+   }  // teardown
+
+   // a second insert of the same key does nothing
+   void test_insert_duplicate()
+   {  // setup
+      custom::flat_hash_set<int> s{ 11, 26, 31 };
+      // exercise
+      custom::pair<custom::flat_hash_set<int>::iterator, bool> result = s.insert(26);
+      // verify
+      assertUnit(!result.second);
+      assertUnit(*result.first == 26);
+      assertUnit(s.size() == 3);
+   }  // teardown
+
+   // growing keeps every element and stays under 7/8 full
+   void test_insert_grow()
+   {  // setup
+      custom::flat_hash_set<int> s;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         s.insert(i);
+      // verify
+      assertUnit(s.size() == 1000);
+      assertUnit(s.load_factor() <= s.max_load_factor());
+      bool all = true;
+      for (int i = 0; i < 1000; i++)
+         all = all && s.contains(i);
+      assertUnit(all);
+   }  // teardown
+
+   /***************************************
+    * ERASE
+    ***************************************/
+
+   // a group that still has an EMPTY slot gets EMPTY back
+   void test_erase_leavesEmpty()
+   {  // setup
+      custom::flat_hash_set<int> s{ 11, 26, 31 };
+      size_t index = s.find(26).index;
+      size_t growthLeft = s.growthLeft;
+      // exercise
+      s.erase(26);
+      // verify
+      assertUnit(s.ctrl[index] == CollidingSet::EMPTY);
+      assertUnit(s.growthLeft == growthLeft + 1);
+      assertUnit(!s.contains(26));
+      assertUnit(s.size() == 2);
+   }  // teardown
+
+   // a full group gets a tombstone so later probes keep going
+   void test_erase_leavesTombstone()
+   {  // setup
+      CollidingSet s;
+      setupFullGroup(s);
+      size_t index = s.find(5).index;
+      size_t growthLeft = s.growthLeft;
+      // exercise
+      s.erase(5);
+      // verify
+      assertUnit(s.ctrl[index] == CollidingSet::DELETED);
+      assertUnit(s.growthLeft == growthLeft);
+      assertUnit(!s.contains(5));
+      assertUnit(s.contains(19));
+   }  // teardown
+
+   // the next insert on that probe path fills the tombstone
+   void test_insert_reusesTombstone()
+   {  // setup
+      CollidingSet s;
+      setupFullGroup(s);
+      size_t index = s.find(5).index;
+      s.erase(5);
+      size_t growthLeft = s.growthLeft;
+      // exercise
+      s.insert(99);
+      // verify
+      assertUnit(s.find(99).index == index);
+      assertUnit(s.ctrl[index] >= 0);
+      assertUnit(s.growthLeft == growthLeft);
+      assertUnit(s.size() == 20);
+      assertUnit(s.contains(19));
+   }  // teardown
+
+   // rehashing at the same capacity drops the tombstones
+   void test_rehash_sweepsTombstones()
+   {  // setup
+      CollidingSet s;
+      setupFullGroup(s);
+      s.erase(5);
+      s.erase(6);
+      size_t numSlots = s.bucket_count();
+      // exercise
+      s.rehash(CollidingSet::growthFor(numSlots));
+      // verify
+      assertUnit(s.bucket_count() == numSlots);
+      assertUnit(s.growthLeft + s.size() == CollidingSet::growthFor(numSlots));
+      bool noTombstones = true;
+      for (size_t i = 0; i < s.bucket_count(); i++)
+         noTombstones = noTombstones && s.ctrl[i] != CollidingSet::DELETED;
+      assertUnit(noTombstones);
+      assertUnit(s.size() == 18);
+      assertUnit(s.contains(19) && !s.contains(5));
+   }  // teardown
+
+   /*************************************************************
+    * SETUP FULL GROUP
+    *    0 through 19, all with the same hash, in 64 slots:
+    *    the first group is full and spills into the next
+    *************************************************************/
+   void setupFullGroup(CollidingSet& s)
+   {
+      s.reserve(40);
+      for (int i = 0; i < 20; i++)
+         s.insert(i);
+   }
+};
+
+#endif // DEBUG
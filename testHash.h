@@ -0,0 +1,769 @@
+/***********************************************************************
+ * Header:
+ *    TEST HASH
+ * Summary:
+ *    Unit tests for hash_table and unordered_set
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "hash.h"
+#include "unitTest.h"
+#include <string>
+#include <sstream>
+#include <iterator>
+#include <vector>
+
+class TestHash : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+      test_constructMove_standard();
+      test_constructRange_standard();
+
+      // Assign
+      test_assign_standard();
+      test_assign_keepsIncremental();
+
+      // Access
+      test_find_standard();
+      test_bucket_standard();
+      test_bucket_afterMove();
+      test_find_duringMigration();
+      test_find_doesNotMigrate();
+      test_iterate_duringMigration();
+      test_find_transparent();
+      test_contains_transparent();
+      test_iterate_sparse();
+      test_nextOccupied_acrossWords();
+      test_stats_chains();
+      test_stats_duringMigration();
+      test_stats_counters();
+      test_find_filtered();
+
+      // Insert
+      test_insert_grow();
+      test_insert_afterMove();
+      test_insert_startsMigration();
+      test_insert_finishesMigration();
+      test_insert_cachesHash();
+      test_rehash_cachedHash();
+      test_insertRange_reservesOnce();
+      test_insertRange_duplicates();
+      test_insertRange_input();
+      test_insertRange_incremental();
+      test_insertRange_afterMove();
+
+      // Remove
+      test_erase_standard();
+      test_erase_migrates();
+      test_erase_transparent();
+      test_erase_clearsBit();
+      test_clear_clearsBits();
+      test_erase_rebuildsFilter();
+
+      report("Hash");
+   }
+
+   // a transparent string hash that counts the std::strings it is handed
+   struct StringHash : custom::hashing::string_hash
+   {
+      StringHash(int* pNumStrings = nullptr) : pNumStrings(pNumStrings) {}
+      using custom::hashing::string_hash::operator ();
+      size_t operator () (const std::string& s) const
+      {
+         if (pNumStrings)
+            (*pNumStrings)++;
+         return custom::hashing::string_hash::operator () (s);
+      }
+      int* pNumStrings;
+   };
+   typedef custom::unordered_set<std::string, StringHash, std::equal_to<>> StringSet;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // eight empty buckets
+   void test_construct_default()
+   {  // exercise
+      custom::unordered_set<int> s;
+      // verify
+      assertUnit(s.empty());
+      assertUnit(s.bucket_count() == 8);
+      assertUnit(s.begin() == s.end());
+      assertUnit(!s.rehashing());
+   }  // teardown
+
+   // a copy holds the same elements in its own buckets
+   void test_constructCopy_standard()
+   {  // setup
+      custom::unordered_set<int> sSrc;
+      setupStandardFixture(sSrc);
+      // exercise
+      custom::unordered_set<int> sDest(sSrc);
+      // verify
+      assertUnit(sDest.buckets != sSrc.buckets);
+      assertStandardFixture(sSrc);
+      assertStandardFixture(sDest);
+   }  // teardown
+
+   // moving takes the buckets and leaves none behind
+   void test_constructMove_standard()
+   {  // setup
+      custom::unordered_set<int> sSrc;
+      setupStandardFixture(sSrc);
+      // exercise
+      custom::unordered_set<int> sDest(std::move(sSrc));
+      // verify
+      assertUnit(sSrc.buckets == nullptr);
+      assertUnit(sSrc.bucket_count() == 0);
+      assertUnit(sSrc.empty());
+      assertStandardFixture(sDest);
+   }  // teardown
+
+   // build from a range with a repeat in it
+   void test_constructRange_standard()
+   {  // setup
+      int a[] = { 11, 26, 31, 26 };
+      // exercise
+      custom::unordered_set<int> s(a, a + 4);
+      // verify
+      assertStandardFixture(s);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign three over two
+   void test_assign_standard()
+   {  // setup
+      custom::unordered_set<int> sSrc;
+      setupStandardFixture(sSrc);
+      custom::unordered_set<int> sDest{ 99, 100 };
+      // exercise
+      sDest = sSrc;
+      // verify
+      assertUnit(!sDest.contains(99));
+      assertStandardFixture(sDest);
+   }  // teardown
+
+   // the copy grows the way the original does
+   void test_assign_keepsIncremental()
+   {  // setup
+      custom::unordered_set<int> sSrc;
+      sSrc.incremental_rehash(true);
+      sSrc.max_load_factor(2.0f);
+      setupStandardFixture(sSrc);
+      custom::unordered_set<int> sDest;
+      // exercise
+      sDest = sSrc;
+      // verify
+      assertUnit(sDest.incremental_rehash());
+      assertUnit(sDest.max_load_factor() == 2.0f);
+      assertStandardFixture(sDest);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // find one there and one not
+   void test_find_standard()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupStandardFixture(s);
+      // exercise
+      custom::unordered_set<int>::iterator itFound = s.find(26);
+      custom::unordered_set<int>::iterator itMissing = s.find(99);
+      // verify
+      assertUnit(itFound != s.end());
+      assertUnit(*itFound == 26);
+      assertUnit(itMissing == s.end());
+      assertUnit(s.count(26) == 1);
+      assertUnit(s.count(99) == 0);
+   }  // teardown
+
+   // the bucket an element reports is the one it sits in
+   void test_bucket_standard()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupStandardFixture(s);
+      // exercise
+      size_t iBucket = s.bucket(31);
+      // verify
+      assertUnit(iBucket < s.bucket_count());
+      bool found = false;
+      for (custom::unordered_set<int>::local_iterator it = s.begin(iBucket); it != s.end(iBucket); ++it)
+         found = found || *it == 31;
+      assertUnit(found);
+   }  // teardown
+
+   // a moved-from table has no buckets to divide by
+   void test_bucket_afterMove()
+   {  // setup
+      custom::unordered_set<int> sSrc;
+      setupStandardFixture(sSrc);
+      custom::unordered_set<int> sDest(std::move(sSrc));
+      // exercise
+      size_t iBucket = sSrc.bucket(31);
+      // verify
+      assertUnit(iBucket == 0);
+      assertUnit(sSrc.bucket_count() == 0);
+   }  // teardown
+
+   // an element not yet migrated is found in the old array
+   void test_find_duringMigration()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupMigrating(s);
+      // exercise
+      custom::unordered_set<int>::iterator it = s.find(6);
+      // verify
+      assertUnit(it != s.end());
+      assertUnit(*it == 6);
+      assertUnit(it.pBucketBegin == s.oldBuckets);
+   }  // teardown
+
+   // lookups only read: the migration stays put and iterators stay good
+   void test_find_doesNotMigrate()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupMigrating(s);
+      custom::unordered_set<int>::iterator it = s.find(6);
+      const custom::unordered_set<int>& sConst = s;
+      // exercise
+      bool found = sConst.contains(5);
+      size_t num = sConst.count(7);
+      bool missing = s.find(99) == s.end();
+      // verify
+      assertUnit(found);
+      assertUnit(num == 1);
+      assertUnit(missing);
+      assertUnit(s.rehashing());
+      assertUnit(s.iMigrate == 4);
+      assertUnit(*it == 6);
+      assertUnit(it == s.find(6));
+   }  // teardown
+
+   // iterating mid-migration visits both arrays once
+   void test_iterate_duringMigration()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupMigrating(s);
+      // exercise
+      int sum = 0;
+      size_t num = 0;
+      for (custom::unordered_set<int>::iterator it = s.begin(); it != s.end(); ++it)
+      {
+         sum += *it;
+         num++;
+      }
+      // verify
+      assertUnit(num == 9);
+      assertUnit(sum == 0 + 1 + 2 + 3 + 4 + 5 + 6 + 7 + 8);
+   }  // teardown
+
+   // find by const char* without building a std::string
+   void test_find_transparent()
+   {  // setup
+      int numStrings = 0;
+      StringSet s(8, StringHash(&numStrings));
+      setupStringFixture(s);
+      numStrings = 0;
+      // exercise
+      StringSet::iterator itFound = s.find("twenty-six");
+      StringSet::iterator itMissing = s.find("ninety-nine");
+      // verify
+      assertUnit(itFound != s.end());
+      assertUnit(*itFound == "twenty-six");
+      assertUnit(itMissing == s.end());
+      assertUnit(numStrings == 0);
+   }  // teardown
+
+   // count and contains take a const char* too, through const
+   void test_contains_transparent()
+   {  // setup
+      int numStrings = 0;
+      StringSet s(8, StringHash(&numStrings));
+      setupStringFixture(s);
+      const StringSet& sConst = s;
+      numStrings = 0;
+      // exercise
+      bool found = sConst.contains("eleven");
+      bool missing = !sConst.contains("twelve");
+      size_t num = sConst.count("thirty-one");
+      // verify
+      assertUnit(found);
+      assertUnit(missing);
+      assertUnit(num == 1);
+      assertUnit(numStrings == 0);
+   }  // teardown
+
+   // a nearly empty table of 1024 buckets visits only its three
+   void test_iterate_sparse()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupStandardFixture(s);
+      s.rehash(1024);
+      // exercise
+      size_t num = 0;
+      for (custom::unordered_set<int>::iterator it = s.begin(); it != s.end(); ++it)
+         num++;
+      // verify
+      assertUnit(num == 3);
+      assertUnit(bitsMatchBuckets(s));
+   }  // teardown
+
+   // the next set bit, skipping whole empty words
+   void test_nextOccupied_acrossWords()
+   {  // setup
+      typedef custom::unordered_set<int> Set;
+      uint64_t bits[3] = { 0, 0, 0 };
+      Set::setBit(bits, 3);
+      Set::setBit(bits, 130);
+      // exercise
+      size_t iFirst = Set::nextOccupied(bits, 0, 150);
+      size_t iSecond = Set::nextOccupied(bits, 4, 150);
+      size_t iNone = Set::nextOccupied(bits, 131, 150);
+      // verify
+      assertUnit(iFirst == 3);
+      assertUnit(iSecond == 130);
+      assertUnit(iNone == 150);
+   }  // teardown
+
+   // 0 8 16 share bucket 0 of 8 and 1 is alone
+   void test_stats_chains()
+   {  // setup
+      custom::unordered_set<int> s;
+      s.insert(0);
+      s.insert(8);
+      s.insert(16);
+      s.insert(1);
+      // exercise
+      custom::hash_stats stats = s.stats();
+      // verify
+      assertUnit(stats.size == 4);
+      assertUnit(stats.bucketCount == 8);
+      assertUnit(stats.loadFactor == 0.5f);
+      assertUnit(stats.maxChain == 3);
+      assertUnit(stats.meanChain == 2.0f);
+      assertUnit(stats.chainLengths[0] == 6);
+      assertUnit(stats.chainLengths[1] == 1);
+      assertUnit(stats.chainLengths[2] == 0);
+      assertUnit(stats.chainLengths[3] == 1);
+   }  // teardown
+
+   // old buckets not yet migrated still count
+   void test_stats_duringMigration()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupMigrating(s);
+      // exercise
+      custom::hash_stats stats = s.stats();
+      // verify
+      assertUnit(stats.size == 9);
+      assertUnit(stats.bucketCount == 16 + 4);
+      size_t numBuckets = 0;
+      for (size_t i = 0; i < custom::hash_stats::HISTOGRAM; i++)
+         numBuckets += stats.chainLengths[i];
+      assertUnit(numBuckets == stats.bucketCount);
+   }  // teardown
+
+   // lookups are counted only with CUSTOM_HASH_STATS
+   void test_stats_counters()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupStandardFixture(s);
+      s.reset_stats();
+      // exercise
+      s.find(26);
+      s.find(99);
+      custom::hash_stats stats = s.stats();
+      // verify
+#ifdef CUSTOM_HASH_STATS
+      assertUnit(stats.hits == 1);
+      assertUnit(stats.misses == 1);
+      assertUnit(stats.hitProbes >= 1.0f);
+#else
+      assertUnit(stats.hits == 0);
+      assertUnit(stats.misses == 0);
+      assertUnit(stats.rehashes == 0);
+#endif
+   }  // teardown
+
+   // with the filter on, every element still passes it and misses stop there
+   void test_find_filtered()
+   {  // setup
+      custom::unordered_set<int> s;
+      s.bloom_filter(true);
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      // exercise
+      bool all = true;
+      for (int i = 0; i < 100; i++)
+         all = all && s.filter.might_contain(std::hash<int>()(i)) && s.contains(i);
+      bool missing = s.find(1000) == s.end();
+      // verify
+      assertUnit(s.bloom_filter());
+      assertUnit(all);
+      assertUnit(missing);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // growing keeps every element and stays under the load factor
+   void test_insert_grow()
+   {  // setup
+      custom::unordered_set<int> s;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         s.insert(i);
+      // verify
+      assertUnit(s.size() == 1000);
+      assertUnit(s.bucket_count() >= 1000);
+      assertUnit(s.load_factor() <= s.max_load_factor());
+      bool all = true;
+      for (int i = 0; i < 1000; i++)
+         all = all && s.contains(i);
+      assertUnit(all);
+   }  // teardown
+
+   // a moved-from table takes inserts again
+   void test_insert_afterMove()
+   {  // setup
+      custom::unordered_set<int> sSrc;
+      setupStandardFixture(sSrc);
+      custom::unordered_set<int> sDest(std::move(sSrc));
+      // exercise
+      setupStandardFixture(sSrc);
+      // verify
+      assertStandardFixture(sSrc);
+   }  // teardown
+
+   // the insert that passes the load factor starts a migration
+   void test_insert_startsMigration()
+   {  // setup
+      custom::unordered_set<int> s;
+      s.incremental_rehash(true);
+      for (int i = 0; i < 8; i++)
+         s.insert(i);
+      // exercise
+      s.insert(8);
+      // verify
+      assertUnit(s.rehashing());
+      assertUnit(s.numOldBuckets == 8);
+      assertUnit(s.bucket_count() == 16);
+      assertUnit(s.iMigrate == 4);
+      assertUnit(s.size() == 9);
+   }  // teardown
+
+   // the next insert moves the rest and frees the old array
+   void test_insert_finishesMigration()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupMigrating(s);
+      // exercise
+      s.insert(9);
+      // verify
+      assertUnit(!s.rehashing());
+      assertUnit(s.oldBuckets == nullptr);
+      assertUnit(s.size() == 10);
+      bool all = true;
+      for (int i = 0; i < 10; i++)
+         all = all && s.contains(i);
+      assertUnit(all);
+   }  // teardown
+
+   // strings keep their hash beside them; ints do not bother
+   void test_insert_cachesHash()
+   {  // setup
+      StringSet s;
+      // exercise
+      s.insert("twenty-six");
+      // verify
+      assertUnit((custom::cache_hash_code<std::string, StringHash>::value));
+      assertUnit((!custom::cache_hash_code<int, std::hash<int>>::value));
+      size_t iBucket = s.bucket("twenty-six");
+      assertUnit(s.buckets[iBucket].size() == 1);
+      if (s.buckets[iBucket].size() == 1)
+         assertUnit(s.buckets[iBucket].front().hash == StringHash()("twenty-six"));
+   }  // teardown
+
+   // with the hashes kept, growing never calls the hasher
+   void test_rehash_cachedHash()
+   {  // setup
+      int numStrings = 0;
+      StringSet s(8, StringHash(&numStrings));
+      setupStringFixture(s);
+      numStrings = 0;
+      // exercise
+      s.rehash(64);
+      // verify
+      assertUnit(s.bucket_count() == 64);
+      assertUnit(numStrings == 0);
+      assertUnit(s.contains("eleven") && s.contains("twenty-six") && s.contains("thirty-one"));
+   }  // teardown
+
+   // a big range grows the table once, straight to its final size
+   void test_insertRange_reservesOnce()
+   {  // setup
+      custom::unordered_set<int> s;
+      std::vector<int> v;
+      for (int i = 0; i < 1000; i++)
+         v.push_back(i);
+      // exercise
+      s.insert(v.begin(), v.end());
+      // verify
+      assertUnit(s.size() == 1000);
+      assertUnit(s.bucket_count() == 1000);
+      bool all = true;
+      for (int i = 0; i < 1000; i++)
+         all = all && s.contains(i);
+      assertUnit(all);
+   }  // teardown
+
+   // keys already there, or twice in the range, go in once
+   void test_insertRange_duplicates()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupStandardFixture(s);
+      std::vector<int> v;
+      for (int i = 0; i < 40; i++)
+         v.push_back(i % 32);
+      // exercise
+      s.insert(v.begin(), v.end());
+      // verify
+      assertUnit(s.size() == 32);
+      assertUnit(s.contains(26) && s.contains(31) && !s.contains(32));
+   }  // teardown
+
+   // a stream can only be read once; every value still arrives
+   void test_insertRange_input()
+   {  // setup
+      custom::unordered_set<int> s;
+      std::istringstream in("11 26 31 26 11");
+      // exercise
+      s.insert(std::istream_iterator<int>(in), std::istream_iterator<int>());
+      // verify
+      assertStandardFixture(s);
+   }  // teardown
+
+   // an incremental table grows as it goes instead of all at once
+   void test_insertRange_incremental()
+   {  // setup
+      custom::unordered_set<int> s;
+      s.incremental_rehash(true);
+      std::vector<int> v;
+      for (int i = 0; i < 100; i++)
+         v.push_back(i);
+      // exercise
+      s.insert(v.begin(), v.end());
+      // verify
+      assertUnit(s.size() == 100);
+      assertUnit(s.bucket_count() == 128);
+      bool all = true;
+      for (int i = 0; i < 100; i++)
+         all = all && s.contains(i);
+      assertUnit(all);
+   }  // teardown
+
+   // a moved-from table has no buckets to prefetch until the first insert
+   void test_insertRange_afterMove()
+   {  // setup
+      custom::unordered_set<int> sSrc;
+      custom::unordered_set<int> sDest(std::move(sSrc));
+      std::vector<int> v;
+      for (int i = 0; i < 100; i++)
+         v.push_back(i);
+      // exercise
+      sSrc.insert(v.begin(), v.end());
+      // verify
+      assertUnit(sSrc.size() == 100);
+      assertUnit(sSrc.contains(0) && sSrc.contains(99));
+   }  // teardown
+
+   /***************************************
+    * ERASE
+    ***************************************/
+
+   // erase the middle one
+   void test_erase_standard()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupStandardFixture(s);
+      // exercise
+      s.erase(26);
+      // verify
+      assertUnit(s.size() == 2);
+      assertUnit(!s.contains(26));
+      assertUnit(s.contains(11) && s.contains(31));
+      assertUnit(s.erase(26) == s.end());
+   }  // teardown
+
+   // an erase moves the rest too
+   void test_erase_migrates()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupMigrating(s);
+      // exercise
+      s.erase(2);
+      // verify
+      assertUnit(!s.rehashing());
+      assertUnit(!s.contains(2));
+      assertUnit(s.contains(6));
+      assertUnit(s.size() == 8);
+   }  // teardown
+
+   // erase by const char* without building a std::string
+   void test_erase_transparent()
+   {  // setup
+      int numStrings = 0;
+      StringSet s(8, StringHash(&numStrings));
+      setupStringFixture(s);
+      numStrings = 0;
+      // exercise
+      s.erase("twenty-six");
+      // verify
+      assertUnit(numStrings == 0);
+      assertUnit(s.size() == 2);
+      assertUnit(!s.contains("twenty-six"));
+      assertUnit(s.contains(std::string("eleven")));
+   }  // teardown
+
+   // emptying a bucket clears its bit
+   void test_erase_clearsBit()
+   {  // setup
+      custom::unordered_set<int> s;
+      setupStandardFixture(s);
+      size_t iBucket = s.bucket(26);
+      // exercise
+      s.erase(26);
+      // verify
+      assertUnit(s.buckets[iBucket].empty());
+      assertUnit((s.occupied[iBucket / 64] & (uint64_t(1) << (iBucket % 64))) == 0);
+      assertUnit(bitsMatchBuckets(s));
+   }  // teardown
+
+   // clear leaves no bit set
+   void test_clear_clearsBits()
+   {  // setup
+      custom::unordered_set<int> s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      // exercise
+      s.clear();
+      // verify
+      assertUnit(s.begin() == s.end());
+      assertUnit(bitsMatchBuckets(s));
+   }  // teardown
+
+   // erasing a quarter as many as remain rebuilds the filter without them
+   void test_erase_rebuildsFilter()
+   {  // setup
+      custom::unordered_set<int> s;
+      s.bloom_filter(true);
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      for (int i = 0; i < 20; i++)
+         s.erase(i);
+      size_t numErased = s.numErased;
+      // exercise
+      s.erase(20);
+      // verify
+      assertUnit(numErased == 20);
+      assertUnit(s.numErased == 0);
+      int numGhosts = 0;
+      for (int i = 0; i <= 20; i++)
+         if (s.filter.might_contain(std::hash<int>()(i)))
+            numGhosts++;
+      assertUnit(numGhosts < 3);
+      bool all = true;
+      for (int i = 21; i < 100; i++)
+         all = all && s.contains(i);
+      assertUnit(all);
+   }  // teardown
+
+   /*************************************************************
+    * BITS MATCH BUCKETS
+    *    Bit i is set exactly when bucket i is not empty
+    *************************************************************/
+   bool bitsMatchBuckets(custom::unordered_set<int>& s)
+   {
+      for (size_t i = 0; i < s.bucket_count(); i++)
+      {
+         bool bit = (s.occupied[i / 64] & (uint64_t(1) << (i % 64))) != 0;
+         if (bit == s.buckets[i].empty())
+            return false;
+      }
+      return true;
+   }
+
+   /*************************************************************
+    * SETUP STRING FIXTURE
+    *    eleven twenty-six thirty-one
+    *************************************************************/
+   void setupStringFixture(StringSet& s)
+   {
+      s.insert("eleven");
+      s.insert("twenty-six");
+      s.insert("thirty-one");
+   }
+
+   /*************************************************************
+    * SETUP MIGRATING
+    *    0 through 8 with incremental rehashing: the ninth grew
+    *    8 buckets to 16 and moved old buckets 0 through 3,
+    *    leaving 4 through 7 to go
+    *************************************************************/
+   void setupMigrating(custom::unordered_set<int>& s)
+   {
+      s.incremental_rehash(true);
+      for (int i = 0; i < 9; i++)
+         s.insert(i);
+   }
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   template <class Set>
+   void setupStandardFixture(Set& s)
+   {
+      s.insert(11);
+      s.insert(26);
+      s.insert(31);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    11 26 31, in any order
+    *************************************************************/
+   template <class Set>
+   void assertStandardFixtureParameters(Set& s, int line, const char* function)
+   {
+      assertIndirect(s.size() == 3);
+      assertIndirect(s.contains(11));
+      assertIndirect(s.contains(26));
+      assertIndirect(s.contains(31));
+      size_t num = 0;
+      for (auto it = s.begin(); it != s.end(); ++it)
+         num++;
+      assertIndirect(num == 3);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,194 @@
+/***********************************************************************
+ * Header:
+ *    TEST HASHING
+ * Summary:
+ *    Unit tests for the hashes and bucket index policies
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "hashing.h"
+#include "unitTest.h"
+#include <cstdint>
+#include <string>
+
+class TestHashing : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Index policies
+      test_moduloIndex_standard();
+      test_maskIndex_bucketCount();
+      test_fastrangeIndex_inRange();
+      test_fastrangeIndex_spreads();
+      test_fastrangeIndex32_spreads();
+      test_fastrangeIndex64_nearExact();
+
+      // Hashes
+      test_mix_fullProduct();
+      test_hashBytes_everyLength();
+      test_hashInteger_highBits();
+      test_hashFloat_negativeZero();
+      test_stringHash_sameForEveryString();
+
+      report("Hashing");
+   }
+
+   /***************************************
+    * INDEX POLICIES
+    ***************************************/
+
+   // the remainder, any bucket count
+   void test_moduloIndex_standard()
+   {  // exercise
+      size_t index = custom::modulo_index::index(31, 11);
+      // verify
+      assertUnit(index == 9);
+      assertUnit(custom::modulo_index::bucket_count(11) == 11);
+   }  // teardown
+
+   // counts round up to a power of two, so the mask is the remainder
+   void test_maskIndex_bucketCount()
+   {  // exercise
+      size_t num = custom::mask_index::bucket_count(26);
+      // verify
+      assertUnit(num == 32);
+      assertUnit(custom::mask_index::bucket_count(32) == 32);
+      assertUnit(custom::mask_index::bucket_count(1) == 1);
+      assertUnit(custom::mask_index::index(31 + 32 * 5, num) == 31);
+   }  // teardown
+
+   // the smallest hash goes first, the largest last
+   void test_fastrangeIndex_inRange()
+   {  // exercise
+      size_t first = custom::fastrange_index::index(0, 11);
+      size_t last = custom::fastrange_index::index(SIZE_MAX, 11);
+      // verify
+      assertUnit(first == 0);
+      assertUnit(last == 10);
+   }  // teardown
+
+   // well-mixed hashes land in every bucket
+   void test_fastrangeIndex_spreads()
+   {  // setup
+      custom::hashing::hash<int> hasher;
+      size_t counts[11] = {};
+      // exercise
+      for (int i = 0; i < 1100; i++)
+         counts[custom::fastrange_index::index(hasher(i), 11)]++;
+      // verify
+      assertUnit(everyBucketUsed(counts, 11));
+   }  // teardown
+
+   // the 32 bit path keeps the whole product: no bucket 0 for everything
+   void test_fastrangeIndex32_spreads()
+   {  // setup
+      size_t counts[11] = {};
+      // exercise
+      for (uint32_t i = 0; i < 1100; i++)
+         counts[custom::fastrange_index::index32(static_cast<uint32_t>(custom::hashing::hash_integer(i)), 11)]++;
+      // verify
+      assertUnit(custom::fastrange_index::index32(0xFFFFFFFFu, 11) == 10);
+      assertUnit(custom::fastrange_index::index32(0x80000000u, 10) == 5);
+      assertUnit(everyBucketUsed(counts, 11));
+   }  // teardown
+
+   // the 64 bit path without a 128 bit product is off by at most one
+   void test_fastrangeIndex64_nearExact()
+   {  // setup
+      uint64_t h = 0xC000000000000000ull;
+      // exercise
+      uint64_t index = custom::fastrange_index::index64(h, 100);
+      uint64_t indexTop = custom::fastrange_index::index64(~uint64_t(0), 100);
+      // verify
+      assertUnit(index == 75);
+      assertUnit(indexTop == 98 || indexTop == 99);
+   }  // teardown
+
+   /***************************************
+    * HASHES
+    ***************************************/
+
+   // the low and high halves of the product are folded together
+   void test_mix_fullProduct()
+   {  // exercise
+      uint64_t low = custom::hashing::mix(3, 5);
+      uint64_t high = custom::hashing::mix(uint64_t(1) << 63, 4);
+      // verify
+      assertUnit(low == 15);
+      assertUnit(high == 2);
+   }  // teardown
+
+   // every length up to 40 bytes hashes differently, and the same twice
+   void test_hashBytes_everyLength()
+   {  // setup
+      const char text[] = "the quick brown fox jumps over the lazy dog";
+      uint64_t hashes[41];
+      // exercise
+      for (size_t len = 0; len <= 40; len++)
+         hashes[len] = custom::hashing::hash_bytes(text, len);
+      // verify
+      bool distinct = true;
+      for (size_t i = 0; i <= 40; i++)
+         for (size_t j = i + 1; j <= 40; j++)
+            distinct = distinct && hashes[i] != hashes[j];
+      assertUnit(distinct);
+      assertUnit(hashes[26] == custom::hashing::hash_bytes(text, 26));
+   }  // teardown
+
+   // neighboring integers differ in the high bits, where fastrange looks
+   void test_hashInteger_highBits()
+   {  // setup
+      custom::hashing::hash<int> hasher;
+      // exercise
+      uint64_t a = hasher(11);
+      uint64_t b = hasher(12);
+      // verify
+      assertUnit((a >> 48) != (b >> 48));
+   }  // teardown
+
+   // -0.0 equals 0.0, so they hash alike
+   void test_hashFloat_negativeZero()
+   {  // setup
+      custom::hashing::hash<double> hasher;
+      // exercise
+      size_t positive = hasher(0.0);
+      size_t negative = hasher(-0.0);
+      // verify
+      assertUnit(positive == negative);
+      assertUnit(hasher(1.0) != positive);
+   }  // teardown
+
+   // std::string and const char* of the same characters hash alike
+   void test_stringHash_sameForEveryString()
+   {  // setup
+      custom::hashing::string_hash hasher;
+      // exercise
+      size_t fromString = hasher(std::string("twenty-six"));
+      size_t fromPointer = hasher("twenty-six");
+      // verify
+      assertUnit(fromString == fromPointer);
+      assertUnit(hasher("thirty-one") != fromPointer);
+   }  // teardown
+
+   /*************************************************************
+    * EVERY BUCKET USED
+    *    No bucket of num was left empty
+    *************************************************************/
+   bool everyBucketUsed(const size_t counts[], size_t num)
+   {
+      for (size_t i = 0; i < num; i++)
+         if (counts[i] == 0)
+            return false;
+      return true;
+   }
+};
+
+#endif // DEBUG
@@ -13,6 +13,22 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testList.h"       // for the spy unit tests
+#include "testQueue.h"      // for the queue unit tests
+#include "testSmallVector.h" // for the small_vector unit tests
+#include "testVector.h"     // for the vector unit tests
+#include "testConcurrentVector.h" // for the concurrent_vector unit tests
+#include "testSoaVector.h"  // for the soa_vector unit tests
+#include "testMappedVector.h" // for the mapped_vector unit tests
+#include "testBitVector.h"  // for the bit_vector unit tests
+#include "testCowVector.h"  // for the cow_vector unit tests
+#include "testPackedIntVector.h" // for the packed_int_vector unit tests
+#include "testStack.h"      // for the stack unit tests
+#include "testFlatHashSet.h" // for the flat_hash_set unit tests
+#include "testHash.h"       // for the unordered_set unit tests
+#include "testUnorderedMap.h" // for the unordered_map unit tests
+#include "testConcurrentUnorderedSet.h" // for the concurrent_unordered_set unit tests
+#include "testBloomFilter.h" // for the blocked_bloom_filter unit tests
+#include "testHashing.h"    // for the hashing unit tests
 
 
 /**********************************************************************
@@ -24,6 +40,22 @@ int main()
 #ifdef DEBUG
    // unit tests
    TestList().run();
+   TestQueue().run();
+   TestSmallVector().run();
+   TestVector().run();
+   TestConcurrentVector().run();
+   TestSoaVector().run();
+   TestMappedVector().run();
+   TestBitVector().run();
+   TestCowVector().run();
+   TestPackedIntVector().run();
+   TestStack().run();
+   TestFlatHashSet().run();
+   TestHash().run();
+   TestUnorderedMap().run();
+   TestConcurrentUnorderedSet().run();
+   TestBloomFilter().run();
+   TestHashing().run();
 #endif // DEBUG
    
    return 0;
@@ -0,0 +1,288 @@
+/***********************************************************************
+ * Header:
+ *    TEST MAPPED VECTOR
+ * Summary:
+ *    Unit tests for mapped_vector. They write scratch files in the
+ *    working directory and remove them again.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "mapped_vector.h"
+#include "unitTest.h"
+#include <cstdio>     // for std::fopen and std::remove
+
+class TestMappedVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_newFile();
+      test_construct_reopen();
+      test_construct_tooSmall();
+      test_construct_otherType();
+      test_construct_otherTag();
+      test_constructMove_standard();
+
+      // Insert
+      test_pushBack_grow();
+      test_resize_fill();
+
+      // Remove
+      test_shrinkToFit_standard();
+
+      report("MappedVector");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a new file gets an empty header
+   void test_construct_newFile()
+   {  // setup
+      std::remove(FILE_NAME);
+      {
+         // exercise
+         custom::mapped_vector<int> v(FILE_NAME);
+         // verify
+         assertUnit(v.empty());
+         assertUnit(v.capacity() == 0);
+         assertUnit(v.header()->magic == custom::mapped_vector<int>::MAGIC);
+      }
+      // teardown
+      assertUnit(std::remove(FILE_NAME) == 0);
+   }
+
+   // what was written is there when the file is opened again
+   void test_construct_reopen()
+   {  // setup
+      std::remove(FILE_NAME);
+      {
+         custom::mapped_vector<int> v(FILE_NAME);
+         setupStandardFixture(v);
+         v.sync();
+      }
+      {
+         // exercise
+         custom::mapped_vector<int> v(FILE_NAME);
+         // verify
+         assertStandardFixture(v);
+      }
+      // teardown
+      assertUnit(std::remove(FILE_NAME) == 0);
+   }
+
+   // a file shorter than the header is refused and closed again
+   void test_construct_tooSmall()
+   {  // setup
+      std::FILE* f = std::fopen(FILE_NAME, "wb");
+      std::fputs("abc", f);
+      std::fclose(f);
+      int fdBefore = probeDescriptor();
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::mapped_vector<int> v(FILE_NAME);
+      }
+      catch (const char*)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(probeDescriptor() == fdBefore);
+      // teardown
+      assertUnit(std::remove(FILE_NAME) == 0);
+   }
+
+   // a file of ints will not open as doubles
+   void test_construct_otherType()
+   {  // setup
+      std::remove(FILE_NAME);
+      {
+         custom::mapped_vector<int> v(FILE_NAME);
+         setupStandardFixture(v);
+      }
+      int fdBefore = probeDescriptor();
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::mapped_vector<double> v(FILE_NAME);
+      }
+      catch (const char*)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(probeDescriptor() == fdBefore);
+      // teardown
+      assertUnit(std::remove(FILE_NAME) == 0);
+   }
+
+   // same size and alignment, but a different tag
+   void test_construct_otherTag()
+   {  // setup
+      std::remove(FILE_NAME);
+      {
+         custom::mapped_vector<int> v(FILE_NAME, 1);
+         setupStandardFixture(v);
+      }
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::mapped_vector<int> v(FILE_NAME, 2);
+      }
+      catch (const char*)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      {
+         custom::mapped_vector<int> v(FILE_NAME, 1);
+         assertStandardFixture(v);
+      }
+      // teardown
+      assertUnit(std::remove(FILE_NAME) == 0);
+   }
+
+   // moving takes the mapping
+   void test_constructMove_standard()
+   {  // setup
+      std::remove(FILE_NAME);
+      {
+         custom::mapped_vector<int> vSrc(FILE_NAME);
+         setupStandardFixture(vSrc);
+         // exercise
+         custom::mapped_vector<int> vDest(std::move(vSrc));
+         // verify
+         assertUnit(vSrc.pMap == nullptr);
+         assertStandardFixture(vDest);
+      }
+      // teardown
+      assertUnit(std::remove(FILE_NAME) == 0);
+   }
+
+   /***************************************
+    * PUSH BACK and RESIZE
+    ***************************************/
+
+   // push_back doubles the file when it is full
+   void test_pushBack_grow()
+   {  // setup
+      std::remove(FILE_NAME);
+      {
+         custom::mapped_vector<int> v(FILE_NAME);
+         v.push_back(11);
+         v.push_back(26);
+         // exercise
+         v.push_back(v[0]);
+         // verify
+         assertUnit(v.size() == 3);
+         assertUnit(v.capacity() == 4);
+         assertUnit(v[2] == 11);
+      }
+      // teardown
+      assertUnit(std::remove(FILE_NAME) == 0);
+   }
+
+   // resize fills the new elements
+   void test_resize_fill()
+   {  // setup
+      std::remove(FILE_NAME);
+      {
+         custom::mapped_vector<int> v(FILE_NAME);
+         // exercise
+         v.resize(100, 26);
+         // verify
+         assertUnit(v.size() == 100);
+         assertUnit(v[0] == 26);
+         assertUnit(v[99] == 26);
+      }
+      // teardown
+      assertUnit(std::remove(FILE_NAME) == 0);
+   }
+
+   /***************************************
+    * SHRINK TO FIT
+    ***************************************/
+
+   // the file is cut down to the elements in use
+   void test_shrinkToFit_standard()
+   {  // setup
+      std::remove(FILE_NAME);
+      {
+         custom::mapped_vector<int> v(FILE_NAME);
+         v.reserve(100);
+         setupStandardFixture(v);
+         // exercise
+         v.shrink_to_fit();
+         // verify
+         assertUnit(v.capacity() == 3);
+         assertStandardFixture(v);
+      }
+      // teardown
+      assertUnit(std::remove(FILE_NAME) == 0);
+   }
+
+   /*************************************************************
+    * PROBE DESCRIPTOR
+    *    The lowest free file descriptor. If a failed open leaks
+    *    one, the next probe comes back higher. Windows has no
+    *    such numbering; there std::remove fails on a file that
+    *    is still open instead.
+    *************************************************************/
+   int probeDescriptor()
+   {
+#ifdef _WIN32
+      return 0;
+#else
+      int fd = ::open(FILE_NAME, O_RDONLY);
+      if (fd >= 0)
+         ::close(fd);
+      return fd;
+#endif
+   }
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   void setupStandardFixture(custom::mapped_vector<int>& v)
+   {
+      v.push_back(11);
+      v.push_back(26);
+      v.push_back(31);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::mapped_vector<int>& v, int line, const char* function)
+   {
+      assertIndirect(v.size() == 3);
+      if (v.size() == 3)
+      {
+         assertIndirect(v[0] == 11);
+         assertIndirect(v[1] == 26);
+         assertIndirect(v[2] == 31);
+      }
+   }
+
+   const char* const FILE_NAME = "testMappedVector.tmp";
+};
+
+#endif // DEBUG
@@ -0,0 +1,197 @@
+/***********************************************************************
+ * Header:
+ *    TEST PACKED INT VECTOR
+ * Summary:
+ *    Unit tests for packed_int_vector
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "packed_int_vector.h"
+#include "unitTest.h"
+#include <cstdint>
+
+class TestPackedIntVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializerList();
+
+      // Insert
+      test_pushBack_sealsBlock();
+      test_pushBack_constantBlock();
+      test_pushBack_fullWidth();
+
+      // Access
+      test_subscript_everyWidth();
+      test_iterator_everyWidth();
+      test_seal_interleavesLanes();
+
+      report("PackedIntVector");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing packed, nothing in the tail
+   void test_construct_default()
+   {  // exercise
+      custom::packed_int_vector v;
+      // verify
+      assertUnit(v.empty());
+      assertUnit(v.blocks.empty());
+      assertUnit(v.numTail == 0);
+   }  // teardown
+
+   // a short list stays in the tail
+   void test_construct_initializerList()
+   {  // exercise
+      custom::packed_int_vector v{ 11, 26, 31 };
+      // verify
+      assertUnit(v.size() == 3);
+      assertUnit(v.blocks.empty());
+      assertUnit(v[0] == 11);
+      assertUnit(v.back() == 31);
+   }  // teardown
+
+   /***************************************
+    * PUSH BACK
+    ***************************************/
+
+   // the 128th value packs the block in 2b words
+   void test_pushBack_sealsBlock()
+   {  // setup
+      custom::packed_int_vector v;
+      // exercise
+      for (uint64_t i = 0; i < 130; i++)
+         v.push_back(1000 + i);
+      // verify
+      assertUnit(v.size() == 130);
+      assertUnit(v.blocks.size() == 1);
+      assertUnit(v.numTail == 2);
+      assertUnit(v.blocks[0].base == 1000);
+      assertUnit(v.blocks[0].bits == 7);
+      assertUnit(v.words.size() == 14);
+      assertUnit(v[127] == 1127);
+      assertUnit(v[129] == 1129);
+   }  // teardown
+
+   // a block of one repeated value takes no words at all
+   void test_pushBack_constantBlock()
+   {  // setup
+      custom::packed_int_vector v;
+      // exercise
+      for (size_t i = 0; i < custom::packed_int_vector::BLOCK; i++)
+         v.push_back(26);
+      // verify
+      assertUnit(v.blocks.size() == 1);
+      assertUnit(v.blocks[0].bits == 0);
+      assertUnit(v.words.empty());
+      assertUnit(v[0] == 26);
+      assertUnit(*v.begin() == 26);
+   }  // teardown
+
+   // the whole 64 bit range in one block
+   void test_pushBack_fullWidth()
+   {  // setup
+      custom::packed_int_vector v;
+      // exercise
+      for (size_t i = 0; i < custom::packed_int_vector::BLOCK; i++)
+         v.push_back(i % 2 ? ~uint64_t(0) - i : i);
+      // verify
+      assertUnit(v.blocks[0].bits == 64);
+      assertUnit(v[0] == 0);
+      assertUnit(v[1] == ~uint64_t(0) - 1);
+      assertUnit(v[127] == ~uint64_t(0) - 127);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // operator [] gets back every value of every bit width
+   void test_subscript_everyWidth()
+   {  // setup
+      custom::packed_int_vector v;
+      setupEveryWidth(v);
+      // exercise
+      bool all = true;
+      for (size_t i = 0; i < v.size(); i++)
+         all = all && v[i] == valueFor(i);
+      // verify
+      assertUnit(v.blocks.size() == 65);
+      bool widths = v.blocks.size() == 65;
+      for (size_t b = 0; widths && b < 65; b++)
+         widths = v.blocks[b].bits == b;
+      assertUnit(widths);
+      assertUnit(all);
+   }  // teardown
+
+   // the block-at-a-time iterator decodes every bit width
+   void test_iterator_everyWidth()
+   {  // setup
+      custom::packed_int_vector v;
+      setupEveryWidth(v);
+      // exercise
+      bool all = true;
+      size_t i = 0;
+      for (custom::packed_int_vector::iterator it = v.begin(); it != v.end(); ++it, ++i)
+         all = all && *it == valueFor(i);
+      // verify
+      assertUnit(i == v.size());
+      assertUnit(all);
+   }  // teardown
+
+   // even values fill the first word, odd values the second
+   void test_seal_interleavesLanes()
+   {  // setup
+      custom::packed_int_vector v;
+      // exercise
+      for (uint64_t i = 0; i < custom::packed_int_vector::BLOCK; i++)
+         v.push_back(i % 2);
+      // verify
+      assertUnit(v.blocks[0].bits == 1);
+      assertUnit(v.words.size() == 2);
+      assertUnit(v.words[0] == 0);
+      assertUnit(v.words[1] == ~uint64_t(0));
+   }  // teardown
+
+   /*************************************************************
+    * SETUP EVERY WIDTH
+    *    Block b (0 to 64) needs exactly b bits, plus a short tail
+    *************************************************************/
+   void setupEveryWidth(custom::packed_int_vector& v)
+   {
+      for (size_t i = 0; i < 65 * custom::packed_int_vector::BLOCK + 5; i++)
+         v.push_back(valueFor(i));
+   }
+
+   // value i: 0 and 2^b - 1 in block b, so the range needs exactly b bits
+   uint64_t valueFor(size_t i)
+   {
+      size_t bits = i / custom::packed_int_vector::BLOCK;
+      size_t slot = i % custom::packed_int_vector::BLOCK;
+      if (bits == 0)
+         return 26;
+      if (bits > 64)
+         return slot;
+      uint64_t top = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+      if (slot == 0)
+         return 0;
+      if (slot == 1)
+         return top;
+      return (slot * 0x9E3779B97F4A7C15ull) & top;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,150 @@
+/***********************************************************************
+ * Header:
+ *    TEST QUEUE
+ * Summary:
+ *    Unit tests for queue
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "queue.h"
+#include "unitTest.h"
+
+class TestQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_constructCopy_empty();
+      test_constructCopy_standard();
+      test_constructCopy_vector();
+
+      // Assign
+      test_assign_standardToEmpty();
+
+      // Remove
+      test_drainInto_standard();
+
+      report("Queue");
+   }
+
+   /***************************************
+    * COPY CONSTRUCTOR
+    ***************************************/
+
+   // copy an empty queue
+   void test_constructCopy_empty()
+   {  // setup
+      const custom::queue<int> qSrc;
+      // exercise
+      custom::queue<int> qDest(qSrc);
+      // verify
+      assertUnit(qSrc.empty());
+      assertUnit(qDest.empty());
+   }  // teardown
+
+   // copy a queue of three over the default list
+   void test_constructCopy_standard()
+   {  // setup
+      custom::queue<int> qSrc;
+      setupStandardFixture(qSrc);
+      const custom::queue<int>& qConst = qSrc;
+      // exercise
+      custom::queue<int> qDest(qConst);
+      // verify
+      assertStandardFixture(qSrc);
+      assertStandardFixture(qDest);
+   }  // teardown
+
+   // copy a queue of three over a vector
+   void test_constructCopy_vector()
+   {  // setup
+      custom::queue<int, custom::vector<int>> qSrc;
+      qSrc.push(11);
+      qSrc.push(26);
+      qSrc.push(31);
+      // exercise
+      custom::queue<int, custom::vector<int>> qDest(qSrc);
+      // verify
+      assertUnit(qDest.size() == 3);
+      assertUnit(qDest.front() == 11);
+      assertUnit(qDest.back() == 31);
+      assertUnit(qSrc.size() == 3);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign a queue of three to an empty one
+   void test_assign_standardToEmpty()
+   {  // setup
+      custom::queue<int> qSrc;
+      setupStandardFixture(qSrc);
+      custom::queue<int> qDest;
+      const custom::queue<int>& qConst = qSrc;
+      // exercise
+      qDest = qConst;
+      // verify
+      assertStandardFixture(qSrc);
+      assertStandardFixture(qDest);
+   }  // teardown
+
+   /***************************************
+    * DRAIN INTO
+    ***************************************/
+
+   // drain two of three, front first
+   void test_drainInto_standard()
+   {  // setup
+      custom::queue<int> q;
+      setupStandardFixture(q);
+      custom::vector<int> out;
+      // exercise
+      size_t num = q.drain_into(out, 2);
+      // verify
+      assertUnit(num == 2);
+      assertUnit(out.size() == 2);
+      if (out.size() == 2)
+      {
+         assertUnit(out[0] == 11);
+         assertUnit(out[1] == 26);
+      }
+      assertUnit(q.size() == 1);
+      assertUnit(q.front() == 31);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11 26 31, front to back
+    *************************************************************/
+   void setupStandardFixture(custom::queue<int>& q)
+   {
+      q.push(11);
+      q.push(26);
+      q.push(31);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    11 26 31, front to back
+    *************************************************************/
+   void assertStandardFixtureParameters(custom::queue<int>& q, int line, const char* function)
+   {
+      assertIndirect(q.size() == 3);
+      if (q.size() == 3)
+      {
+         assertIndirect(q.front() == 11);
+         assertIndirect(q.back() == 31);
+      }
+   }
+};
+
+#endif // DEBUG
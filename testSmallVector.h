@@ -0,0 +1,209 @@
+/***********************************************************************
+ * Header:
+ *    TEST SMALL VECTOR
+ * Summary:
+ *    Unit tests for small_vector
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "small_vector.h"
+#include "unitTest.h"
+#include <string>
+
+class TestSmallVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_heap();
+      test_constructMove_inline();
+      test_constructMove_heap();
+
+      // Insert
+      test_pushBack_inline();
+      test_pushBack_spill();
+      test_pushBack_selfAtCapacity();
+      test_pushBackMove_selfAtCapacity();
+
+      // Remove
+      test_shrinkToFit_backInline();
+
+      report("SmallVector");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a new small_vector lives in its inline buffer
+   void test_construct_default()
+   {  // exercise
+      custom::small_vector<int, 4> v;
+      // verify
+      assertUnit(v.empty());
+      assertUnit(v.capacity() == 4);
+      assertUnit(v.is_inline());
+      assertUnit(v.data == v.inlineData());
+   }  // teardown
+
+   // copy one that has spilled to the heap
+   void test_constructCopy_heap()
+   {  // setup
+      custom::small_vector<int, 2> vSrc;
+      setupStandardFixture(vSrc);
+      // exercise
+      custom::small_vector<int, 2> vDest(vSrc);
+      // verify
+      assertStandardFixture(vSrc);
+      assertStandardFixture(vDest);
+      assertUnit(vDest.data != vSrc.data);
+   }  // teardown
+
+   // moving an inline one moves the elements
+   void test_constructMove_inline()
+   {  // setup
+      custom::small_vector<std::string, 4> vSrc;
+      vSrc.push_back("eleven");
+      vSrc.push_back("twenty-six");
+      // exercise
+      custom::small_vector<std::string, 4> vDest(std::move(vSrc));
+      // verify
+      assertUnit(vSrc.empty());
+      assertUnit(vSrc.is_inline());
+      assertUnit(vDest.size() == 2);
+      assertUnit(vDest.is_inline());
+      assertUnit(vDest[0] == "eleven");
+      assertUnit(vDest[1] == "twenty-six");
+   }  // teardown
+
+   // moving a heap one steals the buffer
+   void test_constructMove_heap()
+   {  // setup
+      custom::small_vector<int, 2> vSrc;
+      setupStandardFixture(vSrc);
+      int* pBuffer = vSrc.data;
+      // exercise
+      custom::small_vector<int, 2> vDest(std::move(vSrc));
+      // verify
+      assertUnit(vSrc.empty());
+      assertUnit(vSrc.is_inline());
+      assertUnit(vDest.data == pBuffer);
+      assertStandardFixture(vDest);
+   }  // teardown
+
+   /***************************************
+    * PUSH BACK
+    ***************************************/
+
+   // up to N elements stay inline
+   void test_pushBack_inline()
+   {  // setup
+      custom::small_vector<int, 4> v;
+      // exercise
+      setupStandardFixture(v);
+      // verify
+      assertUnit(v.is_inline());
+      assertStandardFixture(v);
+   }  // teardown
+
+   // the N+1st element moves everything to the heap
+   void test_pushBack_spill()
+   {  // setup
+      custom::small_vector<int, 2> v;
+      v.push_back(11);
+      v.push_back(26);
+      assertUnit(v.is_inline());
+      // exercise
+      v.push_back(31);
+      // verify
+      assertUnit(!v.is_inline());
+      assertUnit(v.capacity() == 4);
+      assertStandardFixture(v);
+   }  // teardown
+
+   // push an element of the vector itself when it must grow
+   void test_pushBack_selfAtCapacity()
+   {  // setup
+      custom::small_vector<std::string, 2> v;
+      v.push_back("eleven");
+      v.push_back("twenty-six");
+      // exercise
+      v.push_back(v[0]);
+      // verify
+      assertUnit(v.size() == 3);
+      assertUnit(v[0] == "eleven");
+      assertUnit(v[2] == "eleven");
+   }  // teardown
+
+   // move an element of the vector itself when it must grow
+   void test_pushBackMove_selfAtCapacity()
+   {  // setup
+      custom::small_vector<std::string, 2> v;
+      v.push_back("eleven");
+      v.push_back("twenty-six");
+      // exercise
+      v.push_back(std::move(v[1]));
+      // verify
+      assertUnit(v.size() == 3);
+      assertUnit(v[0] == "eleven");
+      assertUnit(v[2] == "twenty-six");
+   }  // teardown
+
+   /***************************************
+    * SHRINK TO FIT
+    ***************************************/
+
+   // once everything fits again, come back inline
+   void test_shrinkToFit_backInline()
+   {  // setup
+      custom::small_vector<int, 2> v;
+      setupStandardFixture(v);
+      v.pop_back();
+      // exercise
+      v.shrink_to_fit();
+      // verify
+      assertUnit(v.is_inline());
+      assertUnit(v.size() == 2);
+      assertUnit(v[0] == 11);
+      assertUnit(v[1] == 26);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   template <size_t N>
+   void setupStandardFixture(custom::small_vector<int, N>& v)
+   {
+      v.push_back(11);
+      v.push_back(26);
+      v.push_back(31);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   template <size_t N>
+   void assertStandardFixtureParameters(const custom::small_vector<int, N>& v, int line, const char* function)
+   {
+      assertIndirect(v.size() == 3);
+      if (v.size() == 3)
+      {
+         assertIndirect(v[0] == 11);
+         assertIndirect(v[1] == 26);
+         assertIndirect(v[2] == 31);
+      }
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,187 @@
+/***********************************************************************
+ * Header:
+ *    TEST SOA VECTOR
+ * Summary:
+ *    Unit tests for soa_vector
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "soa_vector.h"
+#include "unitTest.h"
+#include <tuple>
+
+class TestSoaVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sized();
+
+      // Access
+      test_get_column();
+      test_rowAssign_tuple();
+      test_rowAssign_row();
+      test_rowAssign_self();
+
+      // Insert
+      test_pushBack_columnsTogether();
+
+      // Remove
+      test_popBack_standard();
+
+      report("SoaVector");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing in any column
+   void test_construct_default()
+   {  // exercise
+      custom::soa_vector<int, double, char> v;
+      // verify
+      assertUnit(v.empty());
+      assertUnit(v.column<1>().empty());
+   }  // teardown
+
+   // every column gets the same number of rows
+   void test_construct_sized()
+   {  // exercise
+      custom::soa_vector<int, double, char> v(4);
+      // verify
+      assertUnit(v.size() == 4);
+      assertUnit(std::get<0>(v.columns).size() == 4);
+      assertUnit(std::get<1>(v.columns).size() == 4);
+      assertUnit(std::get<2>(v.columns).size() == 4);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // a column is one contiguous array
+   void test_get_column()
+   {  // setup
+      custom::soa_vector<int, double, char> v;
+      setupStandardFixture(v);
+      // exercise
+      custom::column_span<double> doubles = v.column<1>();
+      // verify
+      assertUnit(doubles.size() == 3);
+      assertUnit(doubles[0] == 1.1);
+      assertUnit(&doubles[2] == &doubles[0] + 2);
+      assertUnit(v.get<0>(1) == 26);
+   }  // teardown
+
+   // assigning a tuple to a row writes every column
+   void test_rowAssign_tuple()
+   {  // setup
+      custom::soa_vector<int, double, char> v;
+      setupStandardFixture(v);
+      // exercise
+      v[1] = std::make_tuple(99, 9.9, 'z');
+      // verify
+      assertUnit(v.get<0>(1) == 99);
+      assertUnit(v.get<1>(1) == 9.9);
+      assertUnit(v.get<2>(1) == 'z');
+      assertUnit(v.get<0>(0) == 11);
+   }  // teardown
+
+   // assigning one row to another copies the data, not the proxy
+   void test_rowAssign_row()
+   {  // setup
+      custom::soa_vector<int, double, char> v;
+      setupStandardFixture(v);
+      // exercise
+      v[0] = v[2];
+      // verify
+      assertUnit(v.get<0>(0) == 31);
+      assertUnit(v.get<1>(0) == 3.1);
+      assertUnit(v.get<2>(0) == 'c');
+      assertUnit(v.get<0>(2) == 31);
+   }  // teardown
+
+   // a row assigned to itself is unchanged
+   void test_rowAssign_self()
+   {  // setup
+      custom::soa_vector<int, double, char> v;
+      setupStandardFixture(v);
+      // exercise
+      v[1] = v[1];
+      // verify
+      assertStandardFixture(v);
+   }  // teardown
+
+   /***************************************
+    * PUSH BACK
+    ***************************************/
+
+   // the columns grow together
+   void test_pushBack_columnsTogether()
+   {  // setup
+      custom::soa_vector<int, double, char> v;
+      // exercise
+      setupStandardFixture(v);
+      // verify
+      assertStandardFixture(v);
+      assertUnit(std::get<0>(v.columns).capacity() == std::get<1>(v.columns).capacity());
+      assertUnit(std::get<1>(v.columns).capacity() == std::get<2>(v.columns).capacity());
+   }  // teardown
+
+   /***************************************
+    * POP BACK
+    ***************************************/
+
+   // pop_back takes a row from every column
+   void test_popBack_standard()
+   {  // setup
+      custom::soa_vector<int, double, char> v;
+      setupStandardFixture(v);
+      // exercise
+      v.pop_back();
+      // verify
+      assertUnit(v.size() == 2);
+      assertUnit(std::get<2>(v.columns).size() == 2);
+      assertUnit(std::get<0>(std::tuple<int, double, char>(v.back())) == 26);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    (11, 1.1, a) (26, 2.6, b) (31, 3.1, c)
+    *************************************************************/
+   void setupStandardFixture(custom::soa_vector<int, double, char>& v)
+   {
+      v.push_back(11, 1.1, 'a');
+      v.push_back(26, 2.6, 'b');
+      v.push_back(31, 3.1, 'c');
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    (11, 1.1, a) (26, 2.6, b) (31, 3.1, c)
+    *************************************************************/
+   void assertStandardFixtureParameters(custom::soa_vector<int, double, char>& v, int line, const char* function)
+   {
+      assertIndirect(v.size() == 3);
+      if (v.size() == 3)
+      {
+         assertIndirect(v.get<0>(0) == 11);
+         assertIndirect(v.get<0>(1) == 26);
+         assertIndirect(v.get<0>(2) == 31);
+         assertIndirect(v.get<1>(1) == 2.6);
+         assertIndirect(v.get<2>(2) == 'c');
+      }
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,197 @@
+/***********************************************************************
+ * Header:
+ *    TEST STACK
+ * Summary:
+ *    Unit tests for stack
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "stack.h"
+#include "list.h"
+#include "unitTest.h"
+
+class TestStack : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_constructCopy_standard();
+      test_constructCopy_list();
+
+      // Assign
+      test_assign_list();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_pushRange_standard();
+
+      // Remove
+      test_popN_tooMany();
+      test_drainInto_standard();
+
+      report("Stack");
+   }
+
+   /***************************************
+    * COPY CONSTRUCTOR
+    ***************************************/
+
+   // copy a stack of three over the default vector
+   void test_constructCopy_standard()
+   {  // setup
+      custom::stack<int> sSrc;
+      setupStandardFixture(sSrc);
+      const custom::stack<int>& sConst = sSrc;
+      // exercise
+      custom::stack<int> sDest(sConst);
+      // verify
+      assertStandardFixture(sSrc);
+      assertStandardFixture(sDest);
+   }  // teardown
+
+   // copy a stack of three over a list
+   void test_constructCopy_list()
+   {  // setup
+      custom::stack<int, custom::list<int>> sSrc;
+      sSrc.push(11);
+      sSrc.push(26);
+      sSrc.push(31);
+      const custom::stack<int, custom::list<int>>& sConst = sSrc;
+      // exercise
+      custom::stack<int, custom::list<int>> sDest(sConst);
+      // verify
+      assertUnit(sDest.size() == 3);
+      assertUnit(sDest.top() == 31);
+      assertUnit(sSrc.size() == 3);
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assign a stack of three over a list to an empty one
+   void test_assign_list()
+   {  // setup
+      custom::stack<int, custom::list<int>> sSrc;
+      sSrc.push(11);
+      sSrc.push(26);
+      const custom::stack<int, custom::list<int>>& sConst = sSrc;
+      custom::stack<int, custom::list<int>> sDest;
+      // exercise
+      sDest = sConst;
+      // verify
+      assertUnit(sDest.size() == 2);
+      assertUnit(sDest.top() == 26);
+      assertUnit(sSrc.size() == 2);
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // the top of an empty stack throws
+   void test_top_empty()
+   {  // setup
+      custom::stack<int> s;
+      bool thrown = false;
+      // exercise
+      try
+      {
+         s.top();
+      }
+      catch (const char*)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   /***************************************
+    * PUSH RANGE
+    ***************************************/
+
+   // push three at once, last one on top
+   void test_pushRange_standard()
+   {  // setup
+      custom::stack<int> s;
+      int a[] = { 11, 26, 31 };
+      // exercise
+      s.push_range(a, a + 3);
+      // verify
+      assertStandardFixture(s);
+   }  // teardown
+
+   /***************************************
+    * POP N and DRAIN INTO
+    ***************************************/
+
+   // asking for more than there is empties the stack
+   void test_popN_tooMany()
+   {  // setup
+      custom::stack<int> s;
+      setupStandardFixture(s);
+      // exercise
+      s.pop_n(10);
+      // verify
+      assertUnit(s.empty());
+   }  // teardown
+
+   // drain two of three, top first
+   void test_drainInto_standard()
+   {  // setup
+      custom::stack<int> s;
+      setupStandardFixture(s);
+      custom::vector<int> out;
+      // exercise
+      size_t num = s.drain_into(out, 2);
+      // verify
+      assertUnit(num == 2);
+      assertUnit(out.size() == 2);
+      if (out.size() == 2)
+      {
+         assertUnit(out[0] == 31);
+         assertUnit(out[1] == 26);
+      }
+      assertUnit(s.size() == 1);
+      assertUnit(s.top() == 11);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11 26 31, bottom to top
+    *************************************************************/
+   void setupStandardFixture(custom::stack<int>& s)
+   {
+      s.push(11);
+      s.push(26);
+      s.push(31);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    11 26 31, bottom to top
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::stack<int>& s, int line, const char* function)
+   {
+      assertIndirect(s.size() == 3);
+      if (s.size() == 3)
+      {
+         assertIndirect(s.top() == 31);
+         assertIndirect(s.container[0] == 11);
+         assertIndirect(s.container[1] == 26);
+      }
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,235 @@
+/***********************************************************************
+ * Header:
+ *    TEST UNORDERED MAP
+ * Summary:
+ *    Unit tests for unordered_map
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "unordered_map.h"
+#include "unitTest.h"
+#include <string>
+
+class TestUnorderedMap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_initializerList();
+
+      // Access
+      test_subscript_inserts();
+      test_subscript_existing();
+      test_at_missing();
+
+      // Insert
+      test_tryEmplace_new();
+      test_tryEmplace_existing();
+      test_tryEmplace_hashesOnce();
+      test_insertOrAssign_new();
+      test_insertOrAssign_existing();
+      test_insertOrAssign_hashesOnce();
+
+      report("UnorderedMap");
+   }
+
+   // std::hash, counting how often it is called
+   struct CountingHash
+   {
+      CountingHash(int* pNumCalls = nullptr) : pNumCalls(pNumCalls) {}
+      size_t operator () (int key) const
+      {
+         if (pNumCalls)
+            (*pNumCalls)++;
+         return std::hash<int>()(key);
+      }
+      int* pNumCalls;
+   };
+   typedef custom::unordered_map<int, std::string, CountingHash> CountingMap;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // build from key-value pairs
+   void test_construct_initializerList()
+   {  // exercise
+      custom::unordered_map<int, std::string> m{ { 11, "eleven" }, { 26, "twenty-six" }, { 31, "thirty-one" } };
+      // verify
+      assertStandardFixture(m);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // [] on a missing key adds it with a default value
+   void test_subscript_inserts()
+   {  // setup
+      custom::unordered_map<int, std::string> m;
+      setupStandardFixture(m);
+      // exercise
+      std::string& value = m[99];
+      // verify
+      assertUnit(value.empty());
+      assertUnit(m.size() == 4);
+      assertUnit(m.contains(99));
+   }  // teardown
+
+   // [] on a key already there gives back its value to change
+   void test_subscript_existing()
+   {  // setup
+      custom::unordered_map<int, std::string> m;
+      setupStandardFixture(m);
+      // exercise
+      m[26] = "XXVI";
+      // verify
+      assertUnit(m.size() == 3);
+      assertUnit(m.at(26) == "XXVI");
+   }  // teardown
+
+   // at() on a missing key throws and adds nothing
+   void test_at_missing()
+   {  // setup
+      custom::unordered_map<int, std::string> m;
+      setupStandardFixture(m);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         m.at(99);
+      }
+      catch (const char*)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertStandardFixture(m);
+   }  // teardown
+
+   /***************************************
+    * TRY EMPLACE
+    ***************************************/
+
+   // a new key is added with a value built from the arguments
+   void test_tryEmplace_new()
+   {  // setup
+      custom::unordered_map<int, std::string> m;
+      setupStandardFixture(m);
+      // exercise
+      custom::pair<custom::unordered_map<int, std::string>::iterator, bool> result = m.try_emplace(99, 3, 'x');
+      // verify
+      assertUnit(result.second);
+      assertUnit(result.first->first == 99);
+      assertUnit(result.first->second == "xxx");
+      assertUnit(m.size() == 4);
+   }  // teardown
+
+   // a key already there keeps its value
+   void test_tryEmplace_existing()
+   {  // setup
+      custom::unordered_map<int, std::string> m;
+      setupStandardFixture(m);
+      // exercise
+      custom::pair<custom::unordered_map<int, std::string>::iterator, bool> result = m.try_emplace(26, "XXVI");
+      // verify
+      assertUnit(!result.second);
+      assertUnit(result.first->second == "twenty-six");
+      assertStandardFixture(m);
+   }  // teardown
+
+   // the key is hashed once, hit or miss
+   void test_tryEmplace_hashesOnce()
+   {  // setup
+      int numCalls = 0;
+      CountingMap m(8, CountingHash(&numCalls));
+      m.try_emplace(11, "eleven");
+      numCalls = 0;
+      // exercise
+      m.try_emplace(11, "XI");
+      m.try_emplace(26, "twenty-six");
+      // verify
+      assertUnit(numCalls == 2);
+      assertUnit(m.size() == 2);
+   }  // teardown
+
+   /***************************************
+    * INSERT OR ASSIGN
+    ***************************************/
+
+   // a new key is added
+   void test_insertOrAssign_new()
+   {  // setup
+      custom::unordered_map<int, std::string> m;
+      setupStandardFixture(m);
+      // exercise
+      custom::pair<custom::unordered_map<int, std::string>::iterator, bool> result = m.insert_or_assign(99, "ninety-nine");
+      // verify
+      assertUnit(result.second);
+      assertUnit(result.first->second == "ninety-nine");
+      assertUnit(m.size() == 4);
+   }  // teardown
+
+   // a key already there gets the new value
+   void test_insertOrAssign_existing()
+   {  // setup
+      custom::unordered_map<int, std::string> m;
+      setupStandardFixture(m);
+      // exercise
+      custom::pair<custom::unordered_map<int, std::string>::iterator, bool> result = m.insert_or_assign(26, "XXVI");
+      // verify
+      assertUnit(!result.second);
+      assertUnit(result.first->first == 26);
+      assertUnit(result.first->second == "XXVI");
+      assertUnit(m.size() == 3);
+   }  // teardown
+
+   // the key is hashed once, hit or miss
+   void test_insertOrAssign_hashesOnce()
+   {  // setup
+      int numCalls = 0;
+      CountingMap m(8, CountingHash(&numCalls));
+      m.insert_or_assign(11, "eleven");
+      numCalls = 0;
+      // exercise
+      m.insert_or_assign(11, "XI");
+      m.insert_or_assign(26, "twenty-six");
+      // verify
+      assertUnit(numCalls == 2);
+      assertUnit(m.at(11) == "XI");
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11:eleven 26:twenty-six 31:thirty-one
+    *************************************************************/
+   void setupStandardFixture(custom::unordered_map<int, std::string>& m)
+   {
+      m.insert_or_assign(11, "eleven");
+      m.insert_or_assign(26, "twenty-six");
+      m.insert_or_assign(31, "thirty-one");
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    11:eleven 26:twenty-six 31:thirty-one, in any order
+    *************************************************************/
+   void assertStandardFixtureParameters(custom::unordered_map<int, std::string>& m, int line, const char* function)
+   {
+      assertIndirect(m.size() == 3);
+      assertIndirect(m.contains(11) && m.at(11) == "eleven");
+      assertIndirect(m.contains(26) && m.at(26) == "twenty-six");
+      assertIndirect(m.contains(31) && m.at(31) == "thirty-one");
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,210 @@
+/***********************************************************************
+ * Header:
+ *    TEST VECTOR
+ * Summary:
+ *    Unit tests for the vector emplace, range insert and range erase
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "vector.h"
+#include "unitTest.h"
+#include <string>
+#include <utility>
+
+class TestVector : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Insert
+      test_emplaceBack_empty();
+      test_emplaceBack_grow();
+      test_emplace_front();
+      test_emplace_end();
+      test_insertRange_middle();
+      test_insertRange_empty();
+
+      // Remove
+      test_eraseRange_middle();
+      test_eraseRange_all();
+      test_eraseRange_none();
+
+      report("Vector");
+   }
+
+   /***************************************
+    * EMPLACE BACK
+    ***************************************/
+
+   // build an element in place in an empty vector
+   void test_emplaceBack_empty()
+   {  // setup
+      custom::vector<std::pair<int, std::string>> v;
+      // exercise
+      std::pair<int, std::string>& r = v.emplace_back(11, "eleven");
+      // verify
+      assertUnit(v.size() == 1);
+      assertUnit(&r == &v[0]);
+      assertUnit(v[0].first == 11);
+      assertUnit(v[0].second == "eleven");
+   }  // teardown
+
+   // emplace_back grows the buffer when it is full
+   void test_emplaceBack_grow()
+   {  // setup
+      custom::vector<int> v;
+      v.emplace_back(11);
+      v.emplace_back(26);
+      size_t capacity = v.capacity();
+      // exercise
+      v.emplace_back(31);
+      // verify
+      assertUnit(v.capacity() > capacity);
+      assertStandardFixture(v);
+   }  // teardown
+
+   /***************************************
+    * EMPLACE
+    ***************************************/
+
+   // emplace at the front shifts everything up one
+   void test_emplace_front()
+   {  // setup
+      custom::vector<int> v;
+      v.push_back(26);
+      v.push_back(31);
+      // exercise
+      custom::vector<int>::iterator it = v.emplace(v.begin(), 11);
+      // verify
+      assertUnit(it == v.begin());
+      assertStandardFixture(v);
+   }  // teardown
+
+   // emplace at the end is emplace_back
+   void test_emplace_end()
+   {  // setup
+      custom::vector<int> v;
+      v.push_back(11);
+      v.push_back(26);
+      // exercise
+      custom::vector<int>::iterator it = v.emplace(v.end(), 31);
+      // verify
+      assertUnit(*it == 31);
+      assertStandardFixture(v);
+   }  // teardown
+
+   /***************************************
+    * INSERT RANGE
+    ***************************************/
+
+   // insert two in the middle
+   void test_insertRange_middle()
+   {  // setup
+      custom::vector<int> v;
+      v.push_back(11);
+      v.push_back(31);
+      int a[] = { 26, 29 };
+      // exercise
+      custom::vector<int>::iterator it = v.insert(++v.begin(), a, a + 2);
+      // verify
+      assertUnit(*it == 26);
+      assertUnit(v.size() == 4);
+      if (v.size() == 4)
+      {
+         assertUnit(v[0] == 11);
+         assertUnit(v[1] == 26);
+         assertUnit(v[2] == 29);
+         assertUnit(v[3] == 31);
+      }
+   }  // teardown
+
+   // inserting nothing changes nothing
+   void test_insertRange_empty()
+   {  // setup
+      custom::vector<int> v;
+      setupStandardFixture(v);
+      int a[] = { 99 };
+      // exercise
+      v.insert(v.begin(), a, a);
+      // verify
+      assertStandardFixture(v);
+   }  // teardown
+
+   /***************************************
+    * ERASE RANGE
+    ***************************************/
+
+   // erase the middle one
+   void test_eraseRange_middle()
+   {  // setup
+      custom::vector<int> v;
+      v.push_back(11);
+      v.push_back(20);
+      v.push_back(26);
+      v.push_back(31);
+      // exercise
+      custom::vector<int>::iterator it = v.erase(++v.begin(), ++(++v.begin()));
+      // verify
+      assertUnit(*it == 26);
+      assertStandardFixture(v);
+   }  // teardown
+
+   // erase everything
+   void test_eraseRange_all()
+   {  // setup
+      custom::vector<std::string> v;
+      v.push_back("eleven");
+      v.push_back("twenty-six");
+      // exercise
+      custom::vector<std::string>::iterator it = v.erase(v.begin(), v.end());
+      // verify
+      assertUnit(v.empty());
+      assertUnit(it == v.end());
+   }  // teardown
+
+   // an empty range erases nothing
+   void test_eraseRange_none()
+   {  // setup
+      custom::vector<int> v;
+      setupStandardFixture(v);
+      // exercise
+      v.erase(v.begin(), v.begin());
+      // verify
+      assertStandardFixture(v);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   void setupStandardFixture(custom::vector<int>& v)
+   {
+      v.push_back(11);
+      v.push_back(26);
+      v.push_back(31);
+   }
+
+   /*************************************************************
+    * VERIFY STANDARD FIXTURE
+    *    11 26 31
+    *************************************************************/
+   void assertStandardFixtureParameters(const custom::vector<int>& v, int line, const char* function)
+   {
+      assertIndirect(v.size() == 3);
+      if (v.size() == 3)
+      {
+         assertIndirect(v[0] == 11);
+         assertIndirect(v[1] == 26);
+         assertIndirect(v[2] == 31);
+      }
+   }
+};
+
+#endif // DEBUG
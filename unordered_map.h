@@ -0,0 +1,138 @@
+/***********************************************************************
+ * Header:
+ *    UNORDERED MAP
+ * Summary:
+ *    Our custom implementation of std::unordered_map
+ *      __       ____       ____         __
+ *     /  |    .'    '.   .'    '.   _  / /
+ *     `| |   |  .--.  | |  .--.  | (_)/ /
+ *      | |   | |    | | | |    | |   / / _
+ *     _| |_  |  `--'  | |  `--'  |  / / (_)
+ *    |_____|  '.____.'   '.____.'  /_/
+ *
+ *    This will contain the class definition of:
+ *        unordered_map           : A hash of key-value pairs
+ *
+ *    The buckets, growth, incremental rehash and cached hashes all come
+ *    from hash_table in hash.h. operator [], try_emplace and
+ *    insert_or_assign hash the key once and walk its chain once; a miss
+ *    goes straight into the bucket that walk already found.
+ * Author
+ *    Austin Eldredge
+ ************************************************************************/
+
+#pragma once
+
+#include "hash.h"     // for hash_table
+#include "pair.h"     // for pair
+#include <utility>    // for std::forward
+
+class TestUnorderedMap;     // forward declaration for unit tests
+
+namespace custom
+{
+    /************************************************
+     * UNORDERED MAP
+     * A map implemented as a hash
+     ************************************************/
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+    class unordered_map : public hash_table<K, custom::pair<K, V>, key_of_pair, Hash, KeyEqual>
+    {
+        friend class ::TestUnorderedMap;   // give unit tests access to the privates
+        typedef hash_table<K, custom::pair<K, V>, key_of_pair, Hash, KeyEqual> Base;
+    public:
+        typedef custom::pair<K, V> Pairs;
+        typedef typename Base::iterator iterator;
+
+        //
+        // Construct
+        //
+        unordered_map(size_t numBuckets = 8, const Hash& hasher = Hash(), const KeyEqual& equal = KeyEqual()) :
+            Base(numBuckets, hasher, equal) {}
+        unordered_map(unordered_map& rhs) : Base(rhs) {}
+        unordered_map(unordered_map&& rhs) : Base(std::move(rhs)) {}
+        template <class Iterator>
+        unordered_map(Iterator first, Iterator last) : Base(first, last) {}
+        unordered_map(const std::initializer_list<Pairs>& il) : Base(il) {}
+
+        //
+        // Assign
+        //
+        unordered_map& operator=(unordered_map& rhs)
+        {
+            Base::operator=(rhs);
+            return *this;
+        }
+        unordered_map& operator=(unordered_map&& rhs)
+        {
+            Base::operator=(std::move(rhs));
+            return *this;
+        }
+        unordered_map& operator=(const std::initializer_list<Pairs>& il)
+        {
+            Base::operator=(il);
+            return *this;
+        }
+
+        //
+        // Access
+        //
+        V& operator [] (const K& key)
+        {
+            return try_emplace(key).first->second;
+        }
+        V& at(const K& key)
+        {
+            iterator it = this->find(key);
+            if (it == this->end())
+                throw "std:out_of_range";
+            return it->second;
+        }
+
+        //
+        // Insert
+        //
+        template <class ... Args>
+        custom::pair<iterator, bool> try_emplace(const K& key, Args&& ... args);
+        template <class M>
+        custom::pair<iterator, bool> insert_or_assign(const K& key, M&& value);
+    };
+
+    /*****************************************
+     * UNORDERED MAP :: TRY EMPLACE
+     * Add key with a value built from args, unless
+     * key is already there; then leave it alone
+     ****************************************/
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    template <class ... Args>
+    custom::pair<typename unordered_map <K, V, Hash, KeyEqual> ::iterator, bool>
+        unordered_map <K, V, Hash, KeyEqual> ::try_emplace(const K& key, Args&& ... args)
+    {
+        size_t h = this->hasher(key);
+        iterator it = this->findHashed(key, h);
+        if (it != this->end())
+            return custom::pair<iterator, bool>(it, false);
+        return custom::pair<iterator, bool>(this->insertHashed(Pairs(key, V(std::forward<Args>(args)...)), h), true);
+    }
+
+    /*****************************************
+     * UNORDERED MAP :: INSERT OR ASSIGN
+     * Add key with value, or overwrite the value
+     * already there
+     ****************************************/
+    template <typename K, typename V, typename Hash, typename KeyEqual>
+    template <class M>
+    custom::pair<typename unordered_map <K, V, Hash, KeyEqual> ::iterator, bool>
+        unordered_map <K, V, Hash, KeyEqual> ::insert_or_assign(const K& key, M&& value)
+    {
+        size_t h = this->hasher(key);
+        iterator it = this->findHashed(key, h);
+        if (it != this->end())
+        {
+            it->second = std::forward<M>(value);
+            return custom::pair<iterator, bool>(it, false);
+        }
+        return custom::pair<iterator, bool>(this->insertHashed(Pairs(key, V(std::forward<M>(value))), h), true);
+    }
+
+} // namespace custom
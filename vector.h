@@ -24,6 +24,18 @@
 #include <cassert>  // because I am paranoid
 #include <new>      // std::bad_alloc
 #include <memory>   // for std::allocator
+#include <cstring>  // for std::memmove
+#include <utility>  // for std::move and std::forward
+#include <algorithm>   // for std::move_backward and std::rotate
+#include <iterator>    // for std::iterator_traits
+#include <type_traits> // for std::is_trivially_copyable
+#include <cstdlib>  // for posix_memalign and free
+#ifdef _WIN32
+#include <malloc.h> // for _aligned_malloc
+#endif
+#ifdef __linux__
+#include <sys/mman.h> // for madvise
+#endif
 
 class TestVector; // forward declaration for unit tests
 class TestStack;
@@ -32,18 +44,42 @@ class TestHash;
 
 namespace custom
 {
+    namespace parallel { struct vector_access; }
+
+    /*****************************************
+     * RANGE CATEGORY
+     * Can [first, last) be walked twice? Only an
+     * iterator that calls itself an input iterator,
+     * such as std::istream_iterator, cannot. Ours
+     * do not say, and are all multi-pass.
+     ****************************************/
+    template <class Iterator, class = void>
+    struct range_category
+    {
+        typedef std::forward_iterator_tag type;
+    };
+    template <class Iterator>
+    struct range_category <Iterator, typename std::enable_if<std::is_same<
+        typename std::iterator_traits<Iterator>::iterator_category, std::input_iterator_tag>::value>::type>
+    {
+        typedef std::input_iterator_tag type;
+    };
 
     /*****************************************
      * VECTOR
      * Just like the std :: vector <T> class
+     *   Align : the buffer starts on this boundary, such as 64
+     *           for a cache line (never less than alignof(T))
+     *   Huge  : buffers of 2 MB or more are put on huge pages
      ****************************************/
-    template <typename T>
+    template <typename T, size_t Align = alignof(T), bool Huge = false>
     class vector
     {
         friend class ::TestVector; // give unit tests access to the privates
         friend class ::TestStack;
         friend class ::TestPQueue;
         friend class ::TestHash;
+        friend struct parallel::vector_access; // parallel::filled builds in place
     public:
 
         // 
@@ -54,6 +90,9 @@ namespace custom
         vector(size_t numElements);
         vector(size_t numElements, const T& t);
         vector(const std::initializer_list<T>& l);
+        template <class Iterator,
+            typename std::enable_if<!std::is_integral<Iterator>::value, int>::type = 0>
+        vector(Iterator first, Iterator last);
         vector(const vector& rhs);
         vector(vector&& rhs);
         ~vector();
@@ -78,6 +117,8 @@ namespace custom
         }
         vector& operator = (const vector& rhs);
         vector& operator = (vector&& rhs);
+        template <class Iterator>
+        void assign(Iterator first, Iterator last);
 
         //
         // Iterator
@@ -104,6 +145,14 @@ namespace custom
 
         void push_back(const T& t);
         void push_back(T&& t);
+        template <class ... Args>
+        T& emplace_back(Args&& ... args);
+        template <class ... Args>
+        iterator emplace(iterator pos, Args&& ... args);
+        template <class Iterator>
+        iterator insert(iterator pos, Iterator first, Iterator last);
+        template <class Iterator>
+        void append(Iterator first, Iterator last);
         void reserve(size_t newCapacity);
         void resize(size_t newElements);
         void resize(size_t newElements, const T& t);
@@ -114,9 +163,7 @@ namespace custom
 
         void clear()
         {
-            delete[] data;
             numElements = 0;
-
         }
         void pop_back()
         {
@@ -124,6 +171,7 @@ namespace custom
                 numElements -= 1;
         }
         void shrink_to_fit();
+        iterator erase(iterator first, iterator last);
 
         //
         // Status
@@ -139,6 +187,36 @@ namespace custom
 
     private:
 
+        static_assert((Align & (Align - 1)) == 0, "vector alignment must be a power of two");
+
+        // buffers of at least this many bytes go on huge pages when Huge is set
+        static const size_t hugePageSize = size_t(2) * 1024 * 1024;
+
+        static T* allocate(size_t num);
+        static void deallocate(T* buffer, size_t num);
+        template <class ... Args>
+        void construct(T* p, Args&& ... args);
+        void shift(size_t iFrom, size_t iTo, size_t num);
+        void grow(size_t newElements);
+
+        // a range we can measure first, or one we can only read once
+        template <class Iterator>
+        void appendRange(Iterator first, Iterator last, std::forward_iterator_tag);
+        template <class Iterator>
+        void appendRange(Iterator first, Iterator last, std::input_iterator_tag);
+
+        // the length of a range: subtraction for pointers, a walk otherwise
+        template <class Iterator>
+        static size_t distance(Iterator first, Iterator last);
+        static size_t distance(const T* first, const T* last) { return last - first; }
+        static size_t distance(T* first, T* last) { return last - first; }
+
+        // copy num elements into dest: memcpy from pointers to trivial T
+        template <class Iterator>
+        static void copy(T* dest, Iterator first, size_t num);
+        static void copy(T* dest, const T* first, size_t num);
+        static void copy(T* dest, T* first, size_t num) { copy(dest, const_cast<const T*>(first), num); }
+
         T* data;                 // user data, a dynamically-allocated array
         size_t  numCapacity;       // the capacity of the array
         size_t  numElements;       // the number of items currently used
@@ -155,8 +233,8 @@ namespace custom
      * This particular iterator is a bi-directional meaning
      * that ++ and -- both work.  Not all iterators are that way.
      *************************************************/
-    template <typename T>
-    class vector <T> ::iterator
+    template <typename T, size_t Align, bool Huge>
+    class vector <T, Align, Huge> ::iterator
     {
         friend class ::TestVector; // give unit tests access to the privates
         friend class ::TestStack;
@@ -167,7 +245,7 @@ namespace custom
         iterator() { this->p = nullptr; }
         iterator(T* p) { this->p = p; }
         iterator(const iterator& rhs) { this->p = rhs.p; }
-        iterator(size_t index, vector<T>& v) { this->p = (v.data + index); } //assignment operator taking the location of the element to be refrenced's index? double check this
+        iterator(size_t index, vector& v) { this->p = (v.data + index); } //assignment operator taking the location of the element to be refrenced's index? double check this
         iterator& operator = (const iterator& rhs)
         {
             this->p = rhs.p;          //assign the value of the itterator to be the given itterator
@@ -195,7 +273,7 @@ namespace custom
         // postfix increment
         iterator operator ++ (int postfix)
         {
-            iterator returnCopy(this); //create a copy of the iterator
+            iterator returnCopy(*this); //create a copy of the iterator
             p++; //increment the current pointer (but not the copied one)
             return returnCopy; //return the copy made before iterating
             //idk if this is the most elegant solution, if you find a better one feel free to use it.
@@ -211,7 +289,7 @@ namespace custom
         // postfix decrement
         iterator operator -- (int postfix)
         {
-            iterator returnCopy(this); //create a copy of the iterator
+            iterator returnCopy(*this); //create a copy of the iterator
             p--; //increment the current pointer (but not the copied one)
             return returnCopy; //return the copy made before iterating
             //idk if this is the most elegant solution, if you find a better one feel free to use it.
@@ -226,8 +304,8 @@ namespace custom
      * Default constructor: set the number of elements,
      * construct each element, and copy the values over
      ****************************************/
-    template <typename T>
-    vector <T> ::vector() //deafult constructor allocates no memory unless given parameters
+    template <typename T, size_t Align, bool Huge>
+    vector <T, Align, Huge> ::vector() //deafult constructor allocates no memory unless given parameters
     {
         data = nullptr;
         numCapacity = 0;
@@ -239,10 +317,10 @@ namespace custom
      * non-default constructor: set the number of elements,
      * construct each element, and copy the values over
      ****************************************/
-    template <typename T>
-    vector <T> ::vector(size_t num, const T& t)
+    template <typename T, size_t Align, bool Huge>
+    vector <T, Align, Huge> ::vector(size_t num, const T& t)
     {
-        data = new T[num];
+        data = allocate(num);
         std::fill(data, data + num, t); //copy the element given into the arrays new locations
         numCapacity = num;
         numElements = num;
@@ -252,17 +330,30 @@ namespace custom
      * VECTOR :: INITIALIZATION LIST constructors
      * Create a vector with an initialization list.
      ****************************************/
-    template <typename T>
-    vector <T> ::vector(const std::initializer_list<T>& l)
+    template <typename T, size_t Align, bool Huge>
+    vector <T, Align, Huge> ::vector(const std::initializer_list<T>& l)
     {
-        data = new T[l.size()]; //initialize an array the size of the elements given
-        
+        data = allocate(l.size()); //initialize an array the size of the elements given
         numCapacity = l.size();
         numElements = l.size();
-        for (int i = 0; i < l.size(); i++) {   //fill the array with the given elements
-            data[i] = *(l.begin() + i);
-        }
+        copy(data, l.begin(), l.size());   //fill the array with the given elements
+    }
 
+    /*****************************************
+     * VECTOR :: RANGE constructors
+     * Create a vector from [first, last). A range that
+     * can be walked twice is measured first so there is
+     * one allocation.
+     ****************************************/
+    template <typename T, size_t Align, bool Huge>
+    template <class Iterator,
+        typename std::enable_if<!std::is_integral<Iterator>::value, int>::type>
+    vector <T, Align, Huge> ::vector(Iterator first, Iterator last)
+    {
+        data = nullptr;
+        numCapacity = 0;
+        numElements = 0;
+        append(first, last);
     }
 
     /*****************************************
@@ -270,20 +361,14 @@ namespace custom
      * non-default constructor: set the number of elements,
      * construct each element, and copy the values over
      ****************************************/
-    template <typename T>
-    vector <T> ::vector(size_t num)
+    template <typename T, size_t Align, bool Huge>
+    vector <T, Align, Huge> ::vector(size_t num)
     {
-        if (num != 0) {
-            data = new T[num];
-            for (int i = 0; i < num; i++) { //constructing each element
-                data[i] = T();
-            }
-        }
-        else {
-            data = nullptr;
-        }
+        data = allocate(num);
         numCapacity = num;
         numElements = num;
+        for (size_t i = 0; i < num; i++) //value-initialize, so numbers start at zero
+            data[i] = T();
     }
 
     /*****************************************
@@ -291,8 +376,8 @@ namespace custom
      * Allocate the space for numElements and
      * call the copy constructor on each element
      ****************************************/
-    template <typename T>
-    vector <T> ::vector(const vector& rhs)
+    template <typename T, size_t Align, bool Huge>
+    vector <T, Align, Huge> ::vector(const vector& rhs)
     {
         data = nullptr;
         numElements = 0;
@@ -305,8 +390,8 @@ namespace custom
      * VECTOR :: MOVE CONSTRUCTOR
      * Steal the values from the RHS and set it to zero.
      ****************************************/
-    template <typename T>
-    vector <T> ::vector(vector&& rhs)
+    template <typename T, size_t Align, bool Huge>
+    vector <T, Align, Huge> ::vector(vector&& rhs)
     {
         data = rhs.data;
         rhs.data = nullptr;
@@ -324,14 +409,82 @@ namespace custom
      * Call the destructor for each element from 0..numElements
      * and then free the memory
      ****************************************/
-    template <typename T>
-    vector <T> :: ~vector()
+    template <typename T, size_t Align, bool Huge>
+    vector <T, Align, Huge> :: ~vector()
     {
 
-        delete[] data;
+        deallocate(data, numCapacity);
         data = nullptr;
     }
 
+    /***************************************
+     * VECTOR :: ALLOCATE
+     * Get room for num elements aligned to Align
+     * and default-initialize each of them, which for
+     * a trivial T writes nothing, so no page is touched
+     * until it is used. With Huge
+     * set, a buffer of 2 MB or more is rounded up to
+     * whole 2 MB pages and the kernel is asked to back
+     * it with transparent huge pages.
+     *     INPUT  : num the number of elements
+     *     OUTPUT : the new buffer, or nullptr if num is 0
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    T* vector <T, Align, Huge> ::allocate(size_t num)
+    {
+        if (num == 0)
+            return nullptr;
+
+        size_t bytes = num * sizeof(T);
+        size_t alignment = Align > alignof(T) ? Align : alignof(T);
+        if (Huge && bytes >= hugePageSize)
+        {
+            bytes = (bytes + hugePageSize - 1) / hugePageSize * hugePageSize;
+            alignment = hugePageSize;
+        }
+        if (alignment < sizeof(void*))
+            alignment = sizeof(void*);
+
+#ifdef _WIN32
+        void* p = _aligned_malloc(bytes, alignment);
+#else
+        void* p = nullptr;
+        if (posix_memalign(&p, alignment, bytes) != 0)
+            p = nullptr;
+#endif
+        if (p == nullptr)
+            throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+        if (alignment == hugePageSize)
+            madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+
+        T* buffer = static_cast<T*>(p);
+        for (size_t i = 0; i < num; i++)
+            new (buffer + i) T;
+        return buffer;
+    }
+
+    /***************************************
+     * VECTOR :: DEALLOCATE
+     * Destroy all num elements and free the buffer
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::deallocate(T* buffer, size_t num)
+    {
+        if (buffer == nullptr)
+            return;
+
+        for (size_t i = 0; i < num; i++)
+            buffer[i].~T();
+#ifdef _WIN32
+        _aligned_free(buffer);
+#else
+        free(buffer);
+#endif
+    }
+
     /***************************************
      * VECTOR :: RESIZE
      * This method will adjust the size to newElements.
@@ -339,8 +492,8 @@ namespace custom
      *     INPUT  : newCapacity the size of the new buffer
      *     OUTPUT :
      **************************************/
-    template <typename T>
-    void vector <T> ::resize(size_t newElements)
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::resize(size_t newElements)
     {
         if (newElements > numElements) { //if were adding elements
             reserve(newElements);
@@ -356,8 +509,8 @@ namespace custom
         numElements = newElements;
     }
 
-    template <typename T>
-    void vector <T> ::resize(size_t newElements, const T& t)
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::resize(size_t newElements, const T& t)
     {
         if (newElements > numElements) { //if were adding elements
             reserve(newElements);
@@ -376,23 +529,24 @@ namespace custom
     /***************************************
      * VECTOR :: RESERVE
      * This method will grow the current buffer
-     * to newCapacity.  It will also copy all
+     * to newCapacity.  It will also move all
      * the data from the old buffer into the new
      *     INPUT  : newCapacity the size of the new buffer
      *     OUTPUT :
      **************************************/
-    template <typename T>
-    void vector <T> ::reserve(size_t newCapacity)
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::reserve(size_t newCapacity)
     {
         //only reserve space if were reserving more space.
         if (newCapacity > numCapacity) {
 
             T* oldBuffer = data;
-            T* newBuffer = new T[newCapacity];
-            for (int i = 0; i < numElements; i++) {
-                newBuffer[i] = data[i];
+            T* newBuffer = allocate(newCapacity);
+            for (size_t i = 0; i < numElements; i++) {
+                newBuffer[i] = std::move(oldBuffer[i]);
             }
             data = newBuffer;
+            deallocate(oldBuffer, numCapacity);
 
             numCapacity = newCapacity;
         }
@@ -404,24 +558,48 @@ namespace custom
      *     INPUT  :
      *     OUTPUT :
      **************************************/
-    template <typename T>
-    void vector <T> ::shrink_to_fit()
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::shrink_to_fit()
     {
-        if (numElements == 0) {
-            data = nullptr;
-        }
+        if (numElements == numCapacity)
+            return;
+
+        T* oldBuffer = data;
+        data = allocate(numElements);
+        for (size_t i = 0; i < numElements; i++)
+            data[i] = std::move(oldBuffer[i]);
+        deallocate(oldBuffer, numCapacity);
         numCapacity = numElements;
-
     }
 
 
 
+    /*****************************************
+     * VECTOR :: ERASE
+     * Remove [first, last) and close the gap
+     *     INPUT  : first, last the elements to remove
+     *     OUTPUT : iterator to the element after the last removed
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    typename vector <T, Align, Huge> ::iterator vector <T, Align, Huge> ::erase(iterator first, iterator last)
+    {
+        if (first == last)
+            return first;
+
+        size_t iFirst = &*first - data;
+        size_t iLast = last == end() ? numElements : &*last - data;
+
+        shift(iLast, iFirst, numElements - iLast);
+        numElements -= iLast - iFirst;
+        return iterator(iFirst, *this);
+    }
+
     /*****************************************
      * VECTOR :: SUBSCRIPT
      * Read-Write access
      ****************************************/
-    template <typename T>
-    T& vector <T> :: operator [] (size_t index)
+    template <typename T, size_t Align, bool Huge>
+    T& vector <T, Align, Huge> :: operator [] (size_t index)
     {
         return data[index];
 
@@ -431,8 +609,8 @@ namespace custom
      * VECTOR :: SUBSCRIPT
      * Read-Write access
      *****************************************/
-    template <typename T>
-    const T& vector <T> :: operator [] (size_t index) const
+    template <typename T, size_t Align, bool Huge>
+    const T& vector <T, Align, Huge> :: operator [] (size_t index) const
     {
         if (index < numCapacity) {
 
@@ -447,8 +625,8 @@ namespace custom
      * VECTOR :: FRONT
      * Read-Write access
      ****************************************/
-    template <typename T>
-    T& vector <T> ::front()
+    template <typename T, size_t Align, bool Huge>
+    T& vector <T, Align, Huge> ::front()
     {
 
         return *data;
@@ -458,8 +636,8 @@ namespace custom
      * VECTOR :: FRONT
      * Read-Write access
      *****************************************/
-    template <typename T>
-    const T& vector <T> ::front() const
+    template <typename T, size_t Align, bool Huge>
+    const T& vector <T, Align, Huge> ::front() const
     {
         return *data;
     }
@@ -468,8 +646,8 @@ namespace custom
      * VECTOR :: FRONT
      * Read-Write access
      ****************************************/
-    template <typename T>
-    T& vector <T> ::back()
+    template <typename T, size_t Align, bool Huge>
+    T& vector <T, Align, Huge> ::back()
     {
         return *(&data[numElements - 1]);
     }
@@ -478,8 +656,8 @@ namespace custom
      * VECTOR :: FRONT
      * Read-Write access
      *****************************************/
-    template <typename T>
-    const T& vector <T> ::back() const
+    template <typename T, size_t Align, bool Huge>
+    const T& vector <T, Align, Huge> ::back() const
     {
         return data[numElements - 1];
     }
@@ -492,36 +670,253 @@ namespace custom
      *     INPUT  : 't' the new element to be added
      *     OUTPUT : *this
      **************************************/
-    template <typename T>
-    void vector <T> ::push_back(const T& t)
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::push_back(const T& t)
     {
-        if (numCapacity < numElements + 1) { //add more capacity if needed
-            if (numCapacity == 0) {
-                reserve(1);
-            }
-            else
-                reserve(numElements * 2);
+        emplace_back(t);
+    }
+
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::push_back(T&& t)
+    {
+        emplace_back(std::move(t));
+    }
+
+    /***************************************
+     * VECTOR :: CONSTRUCT
+     * Build a T from args in the slot at p. Every slot
+     * in the buffer already holds a T (allocate() built
+     * one there), so destroy that one first. If building could throw,
+     * build a temporary and move it in instead so the
+     * slot is never left empty.
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    template <class ... Args>
+    void vector <T, Align, Huge> ::construct(T* p, Args&& ... args)
+    {
+        if (std::is_nothrow_constructible<T, Args&&...>::value)
+        {
+            p->~T();
+            new (p) T(std::forward<Args>(args)...);
         }
-        numElements++;
+        else
+            *p = T(std::forward<Args>(args)...);
+    }
 
-        data[numElements - 1] = t;
+    /***************************************
+     * VECTOR :: SHIFT
+     * Slide num elements from iFrom to iTo. The two
+     * ranges may overlap. Trivial types are moved with
+     * memmove, everything else is move-assigned.
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::shift(size_t iFrom, size_t iTo, size_t num)
+    {
+        if (num == 0 || iFrom == iTo)
+            return;
+
+        if (std::is_trivially_copyable<T>::value)
+            std::memmove(static_cast<void*>(data + iTo), data + iFrom, num * sizeof(T));
+        else if (iTo > iFrom)
+            std::move_backward(data + iFrom, data + iFrom + num, data + iTo + num);
+        else
+            std::move(data + iFrom, data + iFrom + num, data + iTo);
+    }
 
+    /***************************************
+     * VECTOR :: EMPLACE BACK
+     * Construct a new element at the end from args.
+     * When the buffer is full, the new element is built
+     * in the new buffer before the old one is released,
+     * so args may refer to elements of this vector.
+     *     INPUT  : args for the constructor of T
+     *     OUTPUT : the new element
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    template <class ... Args>
+    T& vector <T, Align, Huge> ::emplace_back(Args&& ... args)
+    {
+        if (numElements == numCapacity)
+        {
+            size_t newCapacity = numCapacity ? numCapacity * 2 : 1;
+            T* newBuffer = allocate(newCapacity);
+            T* oldBuffer = data;
 
+            data = newBuffer;
+            construct(data + numElements, std::forward<Args>(args)...);
+            for (size_t i = 0; i < numElements; i++)
+                data[i] = std::move(oldBuffer[i]);
+
+            deallocate(oldBuffer, numCapacity);
+            numCapacity = newCapacity;
+        }
+        else
+            construct(data + numElements, std::forward<Args>(args)...);
+
+        return data[numElements++];
     }
 
-    template <typename T>
-    void vector <T> ::push_back(T&& t)
+    /***************************************
+     * VECTOR :: EMPLACE
+     * Construct a new element in front of pos
+     *     INPUT  : pos where the element goes
+     *              args for the constructor of T
+     *     OUTPUT : iterator to the new element
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    template <class ... Args>
+    typename vector <T, Align, Huge> ::iterator vector <T, Align, Huge> ::emplace(iterator pos, Args&& ... args)
     {
-        if (numCapacity < numElements + 1) { //add more capacity if needed
-            if (numCapacity == 0) {
-                reserve(1);
-            }
-            else
-                reserve(numElements * 2);
+        size_t index = pos == end() ? numElements : &*pos - data;
+        if (index == numElements)
+        {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(index, *this);
         }
+
+        // args may refer to an element we are about to move
+        T t(std::forward<Args>(args)...);
+        if (numElements == numCapacity)
+            reserve(numCapacity * 2);
+
+        shift(index, index + 1, numElements - index);
+        data[index] = std::move(t);
         numElements++;
-        data[numElements - 1] = t;
+        return iterator(index, *this);
+    }
+
+    /***************************************
+     * VECTOR :: INSERT
+     * Copy [first, last) in front of pos. The range
+     * is counted first so the buffer grows at most once
+     * and the tail is shifted only once. A range we can
+     * read only once goes on the end and is rotated
+     * into place.
+     *     INPUT  : pos where the elements go
+     *              first, last the elements to copy
+     *     OUTPUT : iterator to the first new element
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    template <class Iterator>
+    typename vector <T, Align, Huge> ::iterator vector <T, Align, Huge> ::insert(iterator pos, Iterator first, Iterator last)
+    {
+        size_t index = pos == end() ? numElements : &*pos - data;
+
+        if (std::is_same<typename range_category<Iterator>::type, std::input_iterator_tag>::value)
+        {
+            size_t numOld = numElements;
+            appendRange(first, last, std::input_iterator_tag());
+            std::rotate(data + index, data + numOld, data + numElements);
+            return iterator(index, *this);
+        }
+
+        size_t num = distance(first, last);
+        if (num == 0)
+            return iterator(index, *this);
+
+        grow(numElements + num);
+        shift(index, index + num, numElements - index);
+        copy(data + index, first, num);
+
+        numElements += num;
+        return iterator(index, *this);
+    }
+
+    /***************************************
+     * VECTOR :: APPEND
+     * Copy [first, last) onto the end with at
+     * most one reallocation, unless the range can
+     * only be read once; then one element at a time
+     *     INPUT  : first, last the elements to copy
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    template <class Iterator>
+    void vector <T, Align, Huge> ::append(Iterator first, Iterator last)
+    {
+        appendRange(first, last, typename range_category<Iterator>::type());
+    }
+
+    template <typename T, size_t Align, bool Huge>
+    template <class Iterator>
+    void vector <T, Align, Huge> ::appendRange(Iterator first, Iterator last, std::forward_iterator_tag)
+    {
+        size_t num = distance(first, last);
+        grow(numElements + num);
+        copy(data + numElements, first, num);
+        numElements += num;
+    }
 
+    template <typename T, size_t Align, bool Huge>
+    template <class Iterator>
+    void vector <T, Align, Huge> ::appendRange(Iterator first, Iterator last, std::input_iterator_tag)
+    {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    /***************************************
+     * VECTOR :: ASSIGN
+     * Replace the contents with [first, last).
+     * The old elements are dropped before growing
+     * so nothing is moved for nothing.
+     *     INPUT  : first, last the elements to copy
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    template <class Iterator>
+    void vector <T, Align, Huge> ::assign(Iterator first, Iterator last)
+    {
+        numElements = 0;
+        append(first, last);
+    }
+
+    /***************************************
+     * VECTOR :: GROW
+     * Make room for newElements, at least doubling
+     * so repeated appends stay amortized O(1)
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::grow(size_t newElements)
+    {
+        if (newElements > numCapacity)
+            reserve(newElements > numCapacity * 2 ? newElements : numCapacity * 2);
+    }
+
+    /***************************************
+     * VECTOR :: DISTANCE
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    template <class Iterator>
+    size_t vector <T, Align, Huge> ::distance(Iterator first, Iterator last)
+    {
+        size_t num = 0;
+        for (auto it = first; it != last; it++)
+            num++;
+        return num;
+    }
+
+    /***************************************
+     * VECTOR :: COPY
+     * The slots in dest already hold a T, so
+     * this assigns rather than constructs
+     **************************************/
+    template <typename T, size_t Align, bool Huge>
+    template <class Iterator>
+    void vector <T, Align, Huge> ::copy(T* dest, Iterator first, size_t num)
+    {
+        for (size_t i = 0; i < num; i++, first++)
+            dest[i] = *first;
+    }
+
+    template <typename T, size_t Align, bool Huge>
+    void vector <T, Align, Huge> ::copy(T* dest, const T* first, size_t num)
+    {
+        if (num == 0)
+            return;
+        if (std::is_trivially_copyable<T>::value)
+            std::memcpy(static_cast<void*>(dest), first, num * sizeof(T));
+        else
+            for (size_t i = 0; i < num; i++)
+                dest[i] = first[i];
     }
 
     /***************************************
@@ -531,8 +926,8 @@ namespace custom
      *     INPUT  : rhs the vector to copy from
      *     OUTPUT : *this
      **************************************/
-    template <typename T>
-    vector <T>& vector <T> :: operator = (const vector& rhs)
+    template <typename T, size_t Align, bool Huge>
+    vector <T, Align, Huge>& vector <T, Align, Huge> :: operator = (const vector& rhs)
     {
         if (rhs.numElements > numElements)
             resize(rhs.numElements);
@@ -544,21 +939,18 @@ namespace custom
         numElements = rhs.numElements;
         return *this;
     }
-    template <typename T>
-    vector <T>& vector <T> :: operator = (vector&& rhs)
+    template <typename T, size_t Align, bool Huge>
+    vector <T, Align, Huge>& vector <T, Align, Huge> :: operator = (vector&& rhs)
     {
-        if (data == nullptr && rhs.data != nullptr) {
-            data = new T[rhs.size()];
-        }
-        
-        for (int i = 0; i < rhs.numElements; i++)
-        {
-            data[i] = rhs[i];
-        }
+        if (this == &rhs)
+            return *this;
+
+        //give back our buffer and take the one from rhs
+        deallocate(data, numCapacity);
+        data = rhs.data;
         numCapacity = rhs.numCapacity;
         numElements = rhs.numElements;
 
-
         //since were taking this from a move operator, we destroy the previous information
         rhs.data = nullptr;
         rhs.numCapacity = 0;